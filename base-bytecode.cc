@@ -0,0 +1,235 @@
+// base-bytecode.cc -- register bytecode backend
+
+/*    Copyright (C) 2018, 2019, 2020 Alexey Protasov (AKA Alex or rusini)
+
+   This file is part of MANOOL.
+
+   MANOOL is free software: you can redistribute it and/or modify it under the terms of the version 3 of the GNU General Public License
+   as published by the Free Software Foundation (and only version 3).
+
+   MANOOL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with MANOOL.  If not, see <https://www.gnu.org/licenses/>.  */
+
+
+# include "config.tcc"
+# include "base.tcc"
+
+# include <cstdlib> // getenv
+# include <cstring> // strcmp
+
+namespace MNL_AUX_UUID { namespace aux {
+   using std::getenv; using std::strcmp;
+
+   const bool use_bytecode = getenv("MNL_BYTECODE") && *getenv("MNL_BYTECODE") && strcmp(getenv("MNL_BYTECODE"), "0");
+
+namespace {
+   // Generic (unspecialized) nodes are lowered to a flat instruction sequence operating on a register file (val[]) local to each activation; temporaries
+   // (tmp_stk slots) are addressed directly. Registers are allocated in stack order, so the arguments of an application end up in consecutive registers and
+   // are passed in place. Any other node is kept as is and executed by the tree-walker (op_exec).
+   class expr_bytecode { MNL_RVALUE()
+      enum: unsigned char {
+         op_nil, op_lit, op_tmp, op_tmp_set, op_tmp_move, op_apply,
+         op_eq, op_ne, op_lt, op_le, op_gt, op_ge, op_add, op_sub, op_mul, op_xor, op_neg, op_abs, op_not,
+         op_exec, op_exec_sig, op_jmp, op_jmp_false, op_ret,
+      };
+      enum { max_fixed_reg_cnt = 16 }; // register files up to this size live in the native stack frame (ISO C++ has no VLAs)
+      struct insn { unsigned char op, argc; int reg, arg, loc; };
+      vector<insn> text; vector<val> lits; vector<code> nodes; vector<loc> locs; int reg_cnt = 0;
+   public:
+      explicit expr_bytecode(const code &body) { int top = 0; lower(body, top, true), emit(op_ret, 0); text.shrink_to_fit(), lits.shrink_to_fit(); }
+      int size() const noexcept { return text.size(); }
+   public:
+      MNL_NOINLINE val execute(bool fast_sig) const { // out-of-line, as the dispatch table refers to local labels
+         static const void *const dispatch[]{
+            &&nil, &&lit, &&tmp, &&tmp_set, &&tmp_move, &&apply,
+            &&eq, &&ne, &&lt, &&le, &&gt, &&ge, &&add, &&sub, &&mul, &&_xor, &&neg, &&abs, &&_not,
+            &&exec, &&exec_sig, &&jmp, &&jmp_false, &&ret,
+         };
+         val fixed_reg[max_fixed_reg_cnt]; vector<val> var_reg;
+         auto reg = MNL_LIKELY(reg_cnt <= max_fixed_reg_cnt) ? fixed_reg : (var_reg.resize(reg_cnt), var_reg.data()); auto pc = text.data();
+      # define MNL_NEXT() goto *dispatch[(++pc)->op]
+         goto *dispatch[pc->op];
+      nil:
+         reg[pc->reg] = {}; MNL_NEXT();
+      lit:
+         reg[pc->reg] = lits[pc->arg]; MNL_NEXT();
+      tmp:
+         reg[pc->reg] = tmp_frm[pc->arg]; MNL_NEXT();
+      tmp_set:
+         tmp_frm[pc->arg] = move(reg[pc->reg]); MNL_NEXT();
+      tmp_move:
+         reg[pc->reg] = move(tmp_frm[pc->arg]); MNL_NEXT();
+      apply:
+         {  auto argv = reg + pc->reg; val res;
+            try { res = move(argv[pc->argc])(pc->argc, argv); } catch (...) { trace_execute(locs[pc->loc]); }
+            for (int sn = pc->argc; sn; --sn) argv[sn] = {};
+            argv[0] = move(res);
+         }
+         MNL_NEXT();
+      # define MNL_M(LABEL, OP) \
+      LABEL: \
+         {  val res; \
+            try { \
+               res = MNL_LIKELY(test<long long>(reg[pc->reg + 1])) ? /* I48 fast path */ \
+                  mnl::OP(move(reg[pc->reg]), cast<long long>(reg[pc->reg + 1])) : mnl::OP(move(reg[pc->reg]), move(reg[pc->reg + 1])); \
+            } catch (...) { trace_execute(locs[pc->loc]); } \
+            reg[pc->reg + 1] = {}, reg[pc->reg] = move(res); \
+         } \
+         MNL_NEXT(); \
+      // end # define MNL_M(LABEL, OP)
+         MNL_M(eq, _eq) MNL_M(ne, _ne) MNL_M(lt, _lt) MNL_M(le, _le) MNL_M(gt, _gt) MNL_M(ge, _ge)
+         MNL_M(add, _add) MNL_M(sub, _sub) MNL_M(mul, _mul)
+      # undef MNL_M
+      _xor:
+         {  val res;
+            try { res = mnl::_xor(move(reg[pc->reg]), move(reg[pc->reg + 1])); } catch (...) { trace_execute(locs[pc->loc]); }
+            reg[pc->reg + 1] = {}, reg[pc->reg] = move(res);
+         }
+         MNL_NEXT();
+      # define MNL_M(LABEL, OP) \
+      LABEL: \
+         {  val res; \
+            try { res = mnl::OP(move(reg[pc->reg])); } catch (...) { trace_execute(locs[pc->loc]); } \
+            reg[pc->reg] = move(res); \
+         } \
+         MNL_NEXT(); \
+      // end # define MNL_M(LABEL, OP)
+         MNL_M(neg, _neg) MNL_M(abs, _abs) MNL_M(_not, _not)
+      # undef MNL_M
+      exec:
+         reg[pc->reg] = nodes[pc->arg].execute(); MNL_NEXT();
+      exec_sig: // in a position where the tree-walker would propagate signals in the fast way
+         reg[pc->reg] = nodes[pc->arg].execute(fast_sig);
+         if (MNL_UNLIKELY(sig_state.first)) return {};
+         MNL_NEXT();
+      jmp:
+         pc = text.data() + pc->arg; goto *dispatch[pc->op];
+      jmp_false:
+         if (MNL_UNLIKELY(!test<bool>(reg[pc->reg]))) MNL_ERR_LOC(locs[pc->loc], MNL_SYM("TypeMismatch"));
+         if (cast<bool>(reg[pc->reg])) MNL_NEXT();
+         pc = text.data() + pc->arg; goto *dispatch[pc->op];
+      ret:
+         return move(reg[pc->reg]);
+      # undef MNL_NEXT
+      }
+   private:
+      int emit(unsigned char op, int reg, int arg = {}, int loc = {}, int argc = {})
+         { text.push_back({op, (unsigned char)argc, reg, arg, loc}); return text.size() - 1; }
+      int emit_loc(const loc &_loc)
+         { locs.push_back(_loc); return locs.size() - 1; }
+      static int op_sym(const code &target, int argc) {
+         if (!test<expr_lit<>>(target) || !test<sym>(cast<const expr_lit<> &>(target).value)) return -1;
+         auto &&op = cast<const sym &>(cast<const expr_lit<> &>(target).value);
+         switch (argc) {
+         case 1:
+            return op == MNL_SYM("Neg") ? op_neg : op == MNL_SYM("Abs") ? op_abs : op == MNL_SYM("~") ? op_not : -1;
+         case 2:
+            return
+               op == MNL_SYM("==") ? op_eq  : op == MNL_SYM("<>") ? op_ne  : op == MNL_SYM("<")   ? op_lt  : op == MNL_SYM("<=") ? op_le :
+               op == MNL_SYM(">")  ? op_gt  : op == MNL_SYM(">=") ? op_ge  : op == MNL_SYM("+")   ? op_add : op == MNL_SYM("-")  ? op_sub :
+               op == MNL_SYM("*")  ? op_mul : op == MNL_SYM("Xor") ? op_xor : -1;
+         }
+         return -1;
+      }
+      void lower_apply(const code &target, initializer_list<const code *> args, const loc &_loc, int &top) {
+         auto reg = top;
+         for (auto &&el: args) lower(*el, top, false);
+         auto op = op_sym(target, args.size());
+         if (op >= 0) emit(op, reg, {}, emit_loc(_loc));
+            else lower(target, top, false), emit(op_apply, reg, {}, emit_loc(_loc), args.size());
+         top = reg + 1;
+      }
+      // Emits code that leaves the value of expr in the register top (on entry) and sets top to the next one
+      void lower(const code &expr, int &top, bool sig) {
+         auto reg = top++; reg_cnt = std::max(reg_cnt, top);
+         if (test<expr_lit<>>(expr))
+            emit(op_lit, reg, lits.size()), lits.push_back(cast<const expr_lit<> &>(expr).value);
+         else
+         if (test<expr_tmp>(expr))
+            emit(op_tmp, reg, cast<const expr_tmp &>(expr).off);
+         else
+         if (test<expr_set<>>(expr) && test<expr_tmp>(cast<const expr_set<> &>(expr).dest)) {
+            top = reg, lower(cast<const expr_set<> &>(expr).src, top, false);
+            emit(op_tmp_set, reg, cast<const expr_tmp &>(cast<const expr_set<> &>(expr).dest).off);
+         } else
+         if (test<expr_move<>>(expr) && test<expr_tmp>(cast<const expr_move<> &>(expr).dest))
+            emit(op_tmp_move, reg, cast<const expr_tmp &>(cast<const expr_move<> &>(expr).dest).off);
+         else
+         if (test<expr_apply0<>>(expr)) {
+            auto &&e = cast<const expr_apply0<> &>(expr);
+            top = reg, lower_apply(e.target, {}, e._loc, top);
+         } else
+         if (test<expr_apply1<>>(expr)) {
+            auto &&e = cast<const expr_apply1<> &>(expr);
+            top = reg, lower_apply(e.target, {&e.arg0}, e._loc, top);
+         } else
+         if (test<expr_apply2<>>(expr)) {
+            auto &&e = cast<const expr_apply2<> &>(expr);
+            top = reg, lower_apply(e.target, {&e.arg0, &e.arg1}, e._loc, top);
+         } else
+         if (test<expr_apply3<>>(expr)) {
+            auto &&e = cast<const expr_apply3<> &>(expr);
+            top = reg, lower_apply(e.target, {&e.arg0, &e.arg1, &e.arg2}, e._loc, top);
+         } else
+         if (test<expr_apply4<>>(expr)) {
+            auto &&e = cast<const expr_apply4<> &>(expr);
+            top = reg, lower_apply(e.target, {&e.arg0, &e.arg1, &e.arg2, &e.arg3}, e._loc, top);
+         } else
+         if (test<expr_seq>(expr)) {
+            top = reg, lower(cast<const expr_seq &>(expr).first, top, sig), emit(op_nil, reg);
+            top = reg, lower(cast<const expr_seq &>(expr).second, top, sig);
+         } else
+         if (test<expr_ifelse<>>(expr)) {
+            auto &&e = cast<const expr_ifelse<> &>(expr);
+            top = reg, lower(e.cond, top, false); auto jmp_false = emit(op_jmp_false, reg, {}, emit_loc(e._loc));
+            top = reg, lower(e.body1, top, sig); auto jmp = emit(op_jmp, reg);
+            text[jmp_false].arg = text.size();
+            top = reg, lower(e.body2, top, sig);
+            text[jmp].arg = text.size();
+         } else
+         if (test<expr_if<>>(expr)) {
+            auto &&e = cast<const expr_if<> &>(expr);
+            top = reg, lower(e.cond, top, false); auto jmp_false = emit(op_jmp_false, reg, {}, emit_loc(e._loc));
+            top = reg, lower(e.body, top, sig);
+            text[jmp_false].arg = text.size();
+            emit(op_nil, reg);
+         } else
+         if (test<expr_while<>>(expr)) {
+            auto &&e = cast<const expr_while<> &>(expr);
+            int start = text.size();
+            top = reg, lower(e.cond, top, false); auto jmp_false = emit(op_jmp_false, reg, {}, emit_loc(e._loc));
+            top = reg, lower(e.body, top, sig), emit(op_nil, reg), emit(op_jmp, reg, start);
+            text[jmp_false].arg = text.size();
+            emit(op_nil, reg);
+         } else
+         if (test<expr_bytecode>(expr)) { // already lowered nested body - splice in
+            auto &&e = cast<const expr_bytecode &>(expr);
+            int text_off = text.size(), lit_off = lits.size(), node_off = nodes.size(), loc_off = locs.size();
+            for (auto &&el: e.text) if (el.op != op_ret) {
+               text.push_back(el), text.back().reg += reg, text.back().loc += loc_off;
+               switch (el.op) {
+               case op_lit:
+                  text.back().arg += lit_off; break;
+               case op_exec: case op_exec_sig:
+                  text.back().arg += node_off; if (!sig) text.back().op = op_exec; break;
+               case op_jmp: case op_jmp_false:
+                  text.back().arg += text_off; break;
+               }
+            }
+            lits.insert(lits.end(), e.lits.begin(), e.lits.end()), nodes.insert(nodes.end(), e.nodes.begin(), e.nodes.end());
+            locs.insert(locs.end(), e.locs.begin(), e.locs.end());
+            reg_cnt = std::max(reg_cnt, reg + e.reg_cnt);
+         } else
+            emit(sig ? op_exec_sig : op_exec, reg, nodes.size()), nodes.push_back(expr);
+         top = reg + 1;
+      }
+   };
+} // namespace
+
+   code lower_bytecode(code &&body) {
+      expr_bytecode res(body);
+      return res.size() > 2 ? move(res) : move(body); // not worth it for a single instruction
+   }
+}} // namespace MNL_AUX_UUID::aux
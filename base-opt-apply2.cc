@@ -20,6 +20,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_apply2<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
    # define MNL_M(OP) \
       match<expr##OP< expr_lit<long long>,          expr_tmp >>                     (res) || \
       match<expr##OP< expr_lit<long long>,          code >>                         (res) || \
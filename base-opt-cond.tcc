@@ -20,6 +20,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(MNL_EXPR<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<MNL_EXPR< expr_not<expr_tmp> >>  (res) ||
       match<MNL_EXPR< expr_not<code> >>      (res) ||
    # define MNL_M(OP) \
@@ -20,6 +20,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_lit<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_lit< long long >>          (res) ||
       match<expr_lit< double >>             (res) ||
       match<expr_lit< float >>              (res) ||
@@ -34,6 +35,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_apply0<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_apply0< expr_lit<> >>  (res) ||
       match<expr_apply0< expr_tmp >>    (res) ||
       match<expr_apply0< code >>        (res);
@@ -43,6 +45,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_apply1<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_not< expr_tmp >>                                          (res) ||
       match<expr_not< code >>                                              (res) ||
       match<expr_neg< expr_tmp >>                                          (res) ||
@@ -65,6 +68,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_apply3<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_apply3< expr_lit<const sym &> >>  (res) ||
       match<expr_apply3< expr_lit<> >>             (res) ||
       match<expr_apply3< expr_tmp >>               (res) ||
@@ -75,6 +79,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_apply4<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_apply4< expr_lit<const sym &> >>  (res) ||
       match<expr_apply4< expr_lit<> >>             (res) ||
       match<expr_apply4< expr_tmp >>               (res) ||
@@ -85,6 +90,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_move<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_move< expr_tmp >>  (res) ||
       match<expr_move< code >>      (res);
    # endif // # ifdef MNL_WITH_OPTIMIZE
@@ -93,6 +99,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_att expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_att_tmp_sym>  (res) ||
       match<expr_att>          (res);
    # endif // # ifdef MNL_WITH_OPTIMIZE
@@ -101,6 +108,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_on<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_on< expr_lit<const sym &> >>  (res) ||
       match<expr_on< expr_tmp >>               (res) ||
       match<expr_on< code >>                   (res);
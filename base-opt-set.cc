@@ -20,6 +20,7 @@ namespace MNL_AUX_UUID { namespace aux {
    code optimize(expr_set<> expr) {
       code res = move(expr);
    # ifdef MNL_WITH_OPTIMIZE
+      if (MNL_LIKELY(!use_bytecode))
       match<expr_set< expr_tmp, expr_lit<long long> >>          (res) ||
       match<expr_set< expr_tmp, expr_lit<double> >>             (res) ||
       match<expr_set< expr_tmp, expr_lit<float> >>              (res) ||
@@ -42,9 +42,9 @@ namespace aux {
 
    struct expr_tmp { MNL_LVALUE(true)
       int off;
-      MNL_INLINE val execute(bool = {}) const { return tmp_stk[tmp_frm + off]; }
-      MNL_INLINE void exec_in(val &&value) const { tmp_stk[tmp_frm + off] = move(value); } // according to tests, better than tmp_stk[tmp_frm + off].swap(value)
-      MNL_INLINE val exec_out() const { return move(tmp_stk[tmp_frm + off]); }
+      MNL_INLINE val execute(bool = {}) const { return tmp_frm[off]; }
+      MNL_INLINE void exec_in(val &&value) const { tmp_frm[off] = move(value); } // according to tests, better than tmp_frm[off].swap(value)
+      MNL_INLINE val exec_out() const { return move(tmp_frm[off]); }
    private:
       MNL_INLINE bool match(const code &) { return {}; }
       friend bool aux::match<>(const code &, expr_tmp &);
@@ -71,11 +71,11 @@ namespace aux {
 
    template<typename Target = code, typename Arg0 = code> struct expr_apply1 {
       MNL_LVALUE(target.is_lvalue())
-      Target target; Arg0 arg0; loc _loc;
+      Target target; Arg0 arg0; loc _loc; apply_cache _cache;
    public:
       MNL_INLINE val execute(bool = {}) const {
          val argv[]{arg0.execute()}; auto &&target = this->target.execute();
-         try { return (move)(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+         try { return _cache((move)(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
       }
       template<typename Val> MNL_INLINE void exec_in(Val &&value) const {
          target.exec_in([&]()->val{
@@ -127,11 +127,11 @@ namespace aux {
 
    template<typename Target = code, typename Arg0 = code, typename Arg1 = code> struct expr_apply2 {
       MNL_LVALUE(target.is_lvalue())
-      Target target; Arg0 arg0; Arg1 arg1; loc _loc;
+      Target target; Arg0 arg0; Arg1 arg1; loc _loc; apply_cache _cache;
    public:
       MNL_INLINE val execute(bool = {}) const {
          val argv[]{arg0.execute(), arg1.execute()}; auto &&target = this->target.execute();
-         try { return (move)(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+         try { return _cache((move)(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
       }
       template<typename Val> MNL_INLINE void exec_in(Val &&value) const {
          target.exec_in([&]()->val{
@@ -186,11 +186,11 @@ namespace aux {
 
    template<typename Target = code, typename Arg0 = code, typename Arg1 = code, typename Arg2 = code> struct expr_apply3 {
       MNL_LVALUE(target.is_lvalue())
-      Target target; Arg0 arg0; Arg1 arg1; Arg2 arg2; loc _loc;
+      Target target; Arg0 arg0; Arg1 arg1; Arg2 arg2; loc _loc; apply_cache _cache;
    public:
       MNL_INLINE val execute(bool = {}) const {
          val argv[]{arg0.execute(), arg1.execute(), arg2.execute()}; auto &&target = this->target.execute();
-         try { return (move)(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+         try { return _cache((move)(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
       }
       template<typename Val> MNL_INLINE void exec_in(Val &&value) const {
          target.exec_in([&]()->val{
@@ -222,11 +222,11 @@ namespace aux {
 
    template<typename Target = code, typename Arg0 = code, typename Arg1 = code, typename Arg2 = code, typename Arg3 = code> struct expr_apply4 {
       MNL_LVALUE(target.is_lvalue())
-      Target target; Arg0 arg0; Arg1 arg1; Arg2 arg2; Arg3 arg3; loc _loc;
+      Target target; Arg0 arg0; Arg1 arg1; Arg2 arg2; Arg3 arg3; loc _loc; apply_cache _cache;
    public:
       MNL_INLINE val execute(bool = {}) const {
          val argv[]{arg0.execute(), arg1.execute(), arg2.execute(), arg3.execute()}; auto &&target = this->target.execute();
-         try { return (move)(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+         try { return _cache((move)(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
       }
       template<typename Val> MNL_INLINE void exec_in(Val &&value) const {
          target.exec_in([&]()->val{
@@ -284,6 +284,13 @@ namespace aux {
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+   struct expr_seq { MNL_LVALUE(second.is_lvalue())
+      code first, second;
+      MNL_INLINE val execute(bool fast_sig) const { if (MNL_UNLIKELY(first.execute(fast_sig), sig_state.first)) return {}; return second.execute(fast_sig); }
+      MNL_INLINE void exec_in(val &&value) const { first.execute(); second.exec_in(move(value)); }
+      MNL_INLINE val exec_out() const { first.execute(); return second.exec_out(); }
+   };
+
    template<typename Cond = code> struct expr_ifelse {
       MNL_LVALUE(body1.is_lvalue() && body2.is_lvalue())
       Cond cond; code body1, body2; loc _loc;
@@ -423,7 +430,7 @@ namespace aux {
          if (MNL_LIKELY(!sig_state.first)) return res; // no signal
          if (MNL_UNLIKELY(sig_state.first == cast<const sym &>(key))) { // caught!
             sig_state.first = {}; auto arg = move(sig_state.second); sig_trace.clear();
-            tmp_stk.push_back(arg); struct _ { MNL_INLINE ~_() { tmp_stk.pop_back(); } } _;
+            tmp_stk.push(move(arg)); struct _ { MNL_INLINE ~_() { tmp_stk.pop(); } } _;
             res = trap.execute(fast_sig); return res;
          }
          if (MNL_LIKELY(fast_sig)) return res; // fast propagation
@@ -442,6 +449,47 @@ namespace aux {
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+   class proc { // value of {proc ...}
+   public:
+      int arg_count, frame_size; code body; vector<unsigned char> mode; // mode is empty unless there are input/output parameters
+   public:
+      MNL_INLINE val invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
+         stk_check();
+         if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+         if (MNL_UNLIKELY(argc != arg_count)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk; auto &tmp_frm = mnl::tmp_frm;)
+         struct _ {
+            tmp_stack &stk; val *&frm, *saved_frm, *saved_top, *saved_lim; int sn;
+            MNL_INLINE ~_() { while (sn) frm[--sn] = {}; frm = saved_frm, stk.top = saved_top, stk.lim = saved_lim; }
+         } _{tmp_stk, tmp_frm, tmp_frm, tmp_stk.top, tmp_stk.lim, 0};
+         tmp_frm = tmp_stk.frame(frame_size);
+         for (; _.sn < argc; ++_.sn) tmp_frm[_.sn] = move(argv[_.sn]);
+         tmp_stk.top = tmp_frm + argc;
+         auto res = body.execute();
+         if (MNL_UNLIKELY(!mode.empty()) && argv_out) for (int sn = argc; sn;) if (MNL_UNLIKELY(mode[--sn])) argv_out[sn].swap(tmp_frm[sn]);
+         // Trampoline for calls left pending by applications in tail position (see compile_apply): the frame is reused for procedures
+         if (MNL_UNLIKELY(tmp_stk.tail.pending) && MNL_LIKELY(tmp_stk.tail.frame == tmp_frm)) for (val caller, callee;;) { // caller keeps the pending call location alive
+            auto &tail = tmp_stk.tail; tail.pending = false;
+            auto &_loc = *tail._loc; caller = move(callee), callee = move(tail.target); int argc = tail.argc;
+            if (MNL_LIKELY(test<proc>(callee)) && MNL_LIKELY(cast<const proc &>(callee).arg_count == argc)) {
+               auto &proc = cast<const class proc &>(callee);
+               while (_.sn) tmp_frm[--_.sn] = {};
+               tmp_stk.top = tmp_frm, tmp_frm = tmp_stk.frame(proc.frame_size);
+               for (; _.sn < argc; ++_.sn) tmp_frm[_.sn].swap(tail.argv[_.sn]);
+               tmp_stk.top = tmp_frm + argc;
+               try { res = proc.body.execute(); } catch (...) { trace_execute(_loc); }
+            } else {
+               val argv[tmp_stack::max_tail_argc]; for (int sn = 0; sn < argc; ++sn) argv[sn].swap(tail.argv[sn]);
+               try { res = move(callee)(argc, argv); } catch (...) { trace_execute(_loc); }
+            }
+            if (MNL_LIKELY(!tail.pending) || MNL_UNLIKELY(tail.frame != tmp_frm)) break;
+         }
+         return res;
+      }
+   };
+
+   /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
    class object: public _record<> {
    public:
       shared_ptr<const _record<>> methods; val cleanup;
@@ -498,13 +546,13 @@ namespace aux {
       expr_tmp obj; expr_lit<const sym &> att; loc _loc;
    public:
       MNL_INLINE val execute(bool) const {
-         auto &obj = tmp_stk[tmp_frm + this->obj.off];
+         auto &obj = tmp_frm[this->obj.off];
          if (MNL_UNLIKELY(!test<object>(obj)) || MNL_UNLIKELY(!cast<const object &>(obj).has(att.value)))
             MNL_ERR_LOC(_loc, MNL_SYM("KeyLookupFailed"));
          return cast<const object &>(obj)[att.value];
       }
       MNL_INLINE void exec_in(val &&value) const {
-         auto &obj = tmp_stk[tmp_frm + this->obj.off];
+         auto &obj = tmp_frm[this->obj.off];
          try {
             if (MNL_UNLIKELY(!test<object>(obj)) || MNL_UNLIKELY(!cast<const object &>(obj).has(att.value)))
                MNL_ERR_LOC(_loc, MNL_SYM("KeyLookupFailed"));
@@ -513,7 +561,7 @@ namespace aux {
          } catch (...) { obj = {}; throw; }
       }
       MNL_INLINE val exec_out() const {
-         auto &obj = tmp_stk[tmp_frm + this->obj.off];
+         auto &obj = tmp_frm[this->obj.off];
          try {
             if (MNL_UNLIKELY(!test<object>(obj)) || MNL_UNLIKELY(!cast<const object &>(obj).has(att.value)))
                MNL_ERR_LOC(_loc, MNL_SYM("KeyLookupFailed"));
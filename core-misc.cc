@@ -16,6 +16,7 @@
 # include "config.tcc"
 # include "mnl-aux-core.tcc"
 
+# include <algorithm> // push_heap, pop_heap
 # include <time.h> // clock_gettime
 # include <cstdio> // sprintf, stderr, fprintf, fputs, fflush
 
@@ -42,7 +43,7 @@ namespace MNL_AUX_UUID { using namespace aux;
       test<sym>(form) && (((const string &)cast<const sym &>(form))[0] >= 'a' && ((const string &)cast<const sym &>(form))[0] <= 'z' ||
       ((const string &)cast<const sym &>(form))[0] == '_' || ((const string &)cast<const sym &>(form))[0] == '`') ?
          MNL_AUX_INIT((code)stub{}) :
-      test<long long>(form) || test<string>(form) || test<sym>(form) ?
+      test<long long>(form) || form.is_string() || test<sym>(form) ?
          [&]()->code{ code make_lit(const val &); return make_lit(form); }() : // actually from MANOOL API
       form.is_list() && !form.empty() ?
          compile(form.front(), form._loc(_loc)).compile(form, form._loc(_loc)) :
@@ -58,55 +59,95 @@ namespace MNL_AUX_UUID { using namespace aux;
    }
 
 // class sym ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-   MNL_PRIORITY(1003) decltype(sym::pool) sym::pool;
-   MNL_IF_WITH_MT(MNL_PRIORITY(1004) decltype(sym::mutex) sym::mutex;)
+   sym::sym(string txt): rep(dict.intern(move(txt))) // precond: txt[0] != '`'
+   {}
+   sym::sym(const char *txt): sym((string)txt)
+   {}
+   sym::sym(decltype(nullptr)): rep(dict.make_unique())
+   {}
+   void sym::free(decltype(rep) rep) noexcept
+      { dict.free(rep); }
 
-   sym::sym(string txt): rep([&]()->decltype(rep){ // precond: txt[0] != '`'
-      MNL_IF_WITH_MT( return std::lock_guard<std::mutex>{mutex}, [&]()->decltype(rep){ )
-         decltype(dict)::const_iterator it = dict.find(txt);
-         if (it != dict.end())
-            return addref(it->second), it->second;
-         if (!pool.empty()) {
-            inverse[pool.back()] = it = dict.insert(make_pair(move(txt), pool.back())).first, pool.pop_back();
-         } else {
-            if (!static_cast<decltype(rep)>(dict.size())) // wrap-around means no more IDs available
-               fputs("MANOOL: FATAL ERROR: Symbol space exhausted\n", stderr), fflush(stderr), _Exit(EXIT_FAILURE);
-            pool.reserve(dict.size() + 1);
-            it = dict.insert(make_pair(move(txt), static_cast<decltype(rep)>(dict.size()))).first, inverse[dict.size() - 1] = it;
+   sym::dictionary::dictionary(initializer_list<pair<const char *, decltype(rep)>> init) {
+      for (auto &&el: stripes) el.slots.resize(16, -1);
+      for (auto &&el: init) {
+         inverse(el.second) = new string(el.first), hash(el.second) = std::hash<string>{}(el.first);
+         if (*el.first != '`') insert(stripes[hash(el.second) & (stripe_count - 1)], el.second);
+         count = std::max(count, (long)el.second + 1);
+      }
+   }
+   auto sym::dictionary::intern(string &&txt)->decltype(rep) {
+      unsigned key = std::hash<string>{}(txt);
+      auto &stripe = stripes[key & (stripe_count - 1)];
+      MNL_IF_WITH_MT( return std::lock_guard<std::mutex>{stripe.mutex}, [&]()->decltype(rep){ )
+         for (auto mask = stripe.slots.size() - 1, index = key / stripe_count & mask;; index = index + 1 & mask) {
+            auto slot = stripe.slots[index];
+            if (slot == -1) break;
+            if (slot >= 0 && hash(static_cast<decltype(rep)>(slot)) == key && *inverse(static_cast<decltype(rep)>(slot)) == txt) {
+            # if MNL_WITH_MULTITHREADING // a symbol whose count has dropped to zero is never resurrected (its free is pending), so skip it
+               auto &count = rc(static_cast<decltype(rep)>(slot));
+               for (auto expected = __atomic_load_n(&count, __ATOMIC_RELAXED); expected;)
+                  if (__atomic_compare_exchange_n(&count, &expected, expected + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) return static_cast<decltype(rep)>(slot);
+            # else
+               return sym::addref(static_cast<decltype(rep)>(slot)), static_cast<decltype(rep)>(slot);
+            # endif
+            }
          }
-         return rc[it->second] = 1, it->second;
+         auto rep = alloc();
+         inverse(rep) = new string(move(txt)), hash(rep) = key, rc(rep) = 1;
+         return insert(stripe, rep), rep;
       MNL_IF_WITH_MT( }(); )
-   }()) {}
-   sym::sym(const char *txt): sym((string)txt)
-   {}
-   sym::sym(decltype(nullptr)): rep([&]()->decltype(rep){
+   }
+   auto sym::dictionary::make_unique()->decltype(rep) {
+      auto mask = MNL_AUX_RAND(unsigned);
+      auto rep = alloc();
+      char txt[sizeof "`4294967295"];
+      sprintf(txt, "`%u", (unsigned)rep ^ mask);
+      return inverse(rep) = new string(txt), rc(rep) = 1, rep;
+   }
+   void sym::dictionary::free(decltype(rep) rep) noexcept { // the caller is the only owner (see intern), so inverse(rep) and hash(rep) are stable
+      if ((*inverse(rep))[0] != '`') { // uninterned symbols are not in the table
+         auto &stripe = stripes[hash(rep) & (stripe_count - 1)];
+         MNL_IF_WITH_MT( std::lock_guard<std::mutex> lock(stripe.mutex); )
+         for (auto mask = stripe.slots.size() - 1, index = hash(rep) / stripe_count & mask;; index = index + 1 & mask) {
+            auto slot = stripe.slots[index];
+            if (slot == -1) break;
+            if (slot == rep) { stripe.slots[index] = -2; break; }
+         }
+      }
+      delete inverse(rep), inverse(rep) = {};
+      MNL_IF_WITH_MT( std::lock_guard<std::mutex>{mutex}, ) pool.push_back(rep), std::push_heap(pool.begin(), pool.end(), std::greater<decltype(rep)>{});
+   }
+   auto sym::dictionary::alloc()->decltype(rep) {
       MNL_IF_WITH_MT( return std::lock_guard<std::mutex>{mutex}, [&]()->decltype(rep){ )
-         auto mask = MNL_AUX_RAND(unsigned short);
-         decltype(dict)::const_iterator it;
-         if (!pool.empty()) {
-            char txt[sizeof "`65535"];
-            sprintf(txt, "`%u", (unsigned)pool.back() ^ mask);
-            inverse[pool.back()] = it = dict.insert(make_pair(move(txt), pool.back())).first, pool.pop_back();
-         } else {
-            if (!static_cast<decltype(rep)>(dict.size())) // wrap-around means no more IDs available
-               fputs("MANOOL: FATAL ERROR: Symbol space exhausted\n", stderr), fflush(stderr), _Exit(EXIT_FAILURE);
-            char txt[sizeof "`65535"];
-            sprintf(txt, "`%u", (unsigned)dict.size() ^ mask);
-            pool.reserve(dict.size() + 1);
-            it = dict.insert(make_pair(move(txt), static_cast<decltype(rep)>(dict.size()))).first, inverse[dict.size() - 1] = it;
+         if (!pool.empty()) { // reuse the lowest free ID, which keeps sym::tab instances compact
+            std::pop_heap(pool.begin(), pool.end(), std::greater<decltype(rep)>{});
+            auto rep = pool.back(); pool.pop_back(); return rep;
          }
-         return rc[it->second] = 1, it->second;
-      MNL_IF_WITH_MT( }(); )
-   }()) {}
-   void sym::free(decltype(rep) rep) noexcept {
-      MNL_IF_WITH_MT( std::lock_guard<std::mutex>{mutex}, [&]{ if (!__atomic_load_n(&rc[rep], __ATOMIC_RELAXED)) )
-         dict.erase(inverse[rep]), pool.push_back(rep);
+         if (count > lim<unsigned>::max()) // no more IDs available
+            fputs("MANOOL: FATAL ERROR: Symbol space exhausted\n", stderr), fflush(stderr), _Exit(EXIT_FAILURE);
+         if (!(count & (1 << seg_bits) - 1) && !segments[count >> seg_bits]) segments[count >> seg_bits] = new segment{}; // never relocated
+         if (pool.capacity() <= (unsigned long)count) pool.reserve(count * 2); // so that free never throws
+         return static_cast<decltype(rep)>(count++);
       MNL_IF_WITH_MT( }(); )
    }
+   void sym::dictionary::insert(stripe &stripe, decltype(rep) rep) { // precond: rep not present
+      if ((stripe.used + 1) * 4 > (long)stripe.slots.size() * 3) { // rehash, dropping tombstones
+         vector<long> slots; slots.swap(stripe.slots);
+         long size = 16; for (auto slot: slots) size += (slot >= 0) * 4;
+         while (size & size - 1) size &= size - 1; stripe.slots.resize(size * 2, -1), stripe.used = 0;
+         for (auto slot: slots) if (slot >= 0) insert(stripe, static_cast<decltype(rep)>(slot));
+      }
+      for (auto mask = stripe.slots.size() - 1, index = hash(rep) / stripe_count & mask;; index = index + 1 & mask)
+         if (stripe.slots[index] < 0) {
+            stripe.used += stripe.slots[index] == -1, stripe.slots[index] = rep;
+            return;
+         }
+   }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    val val::default_invoke(const sym &op, int argc, val argv[]) {
-   switch (MNL_DISP("==", "<>", "Order", "Clone", "DeepClone", "Str")[op]) {
+   switch (MNL_DISP("==", "<>", "Order", "Clone", "DeepClone", "Str", "Hash")[op]) {
    case 1: // ==
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       return  MNL_LIKELY(argv[0].rep.tag() == 0x7FF8u) && argv[0].rep.dat<void *>() == rep.dat<void *>();
@@ -130,10 +171,69 @@ namespace MNL_AUX_UUID { using namespace aux;
    case 6: // Str
       if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       { static MNL_IF_WITH_MT(thread_local) const val res = "value/object"; return res; }
+   case 7: // Hash (consistent with == above)
+      if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      return aux::_hash(reinterpret_cast<uintptr_t>(rep.dat<void *>()));
    case 0:
       MNL_ERR(MNL_SYM("UnrecognizedOperation"));
    }}
 
+// Biased Reference Counting //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+# if MNL_WITH_MULTITHREADING
+   namespace aux { namespace { rc_owner rc_placeholder; } }
+   thread_local rc_owner *aux::rc_self = &rc_placeholder;
+
+   namespace aux { struct rc_exit {
+      bool armed;
+      ~rc_exit() { // objects queued from now on get merged by the releasing thread
+         if (!armed) return;
+         vector<rc_biased *> queue;
+         {  std::lock_guard<std::mutex> _(rc_self->mutex);
+            rc_self->alive = false, queue.swap(rc_self->queue);
+         }
+         for (auto obj: queue) if (obj->merge_explicit()) delete obj;
+      }
+   }; }
+   namespace aux { namespace { thread_local rc_exit _rc_exit; } }
+
+   rc_owner *rc_biased::rc_enter() {
+      if (MNL_UNLIKELY(rc_self == &rc_placeholder)) {
+         rc_self = new rc_owner;
+         rc_self->quiet = rc_self->alive = true;
+         return _rc_exit.armed = true, rc_self;
+      }
+      vector<rc_biased *> queue;
+      {  std::lock_guard<std::mutex> _(rc_self->mutex);
+         queue.swap(rc_self->queue), __atomic_store_n(&rc_self->quiet, true, __ATOMIC_RELAXED);
+      }
+      for (auto obj: queue) if (obj->merge_explicit()) delete obj;
+      return rc_self;
+   }
+   bool rc_biased::merge_implicit() noexcept { // by the owner, once its share has dropped to zero
+      __atomic_store_n(&owner, nullptr, __ATOMIC_RELAXED);
+      return !__atomic_fetch_or(&shared, merged, __ATOMIC_ACQ_REL); // otherwise the last releasing thread (or the owner's queue) deletes
+   }
+   bool rc_biased::merge_explicit() noexcept { // by the owner on a queued object, or by any thread after the owner has gone
+      auto share = __atomic_load_n(&biased, __ATOMIC_RELAXED);
+      __atomic_store_n(&biased, 0u, __ATOMIC_RELAXED), __atomic_store_n(&owner, nullptr, __ATOMIC_RELAXED);
+      for (auto res = __atomic_load_n(&shared, __ATOMIC_RELAXED);;)
+         if (__atomic_compare_exchange_n(&shared, &res, (res + (int)(share << 2) | merged) & ~queued, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+            return ((res + (int)(share << 2) | merged) & ~queued) == merged;
+   }
+   bool rc_biased::enqueue(int res) noexcept { // by a non-owner that has just driven the shared count negative
+      for (;;) {
+         if (res & queued || res >= 0) return false;
+         if (__atomic_compare_exchange_n(&shared, &res, res | queued, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) break;
+      }
+      auto owner = __atomic_load_n(&this->owner, __ATOMIC_RELAXED); // not merged yet, since the count is negative
+      {  std::lock_guard<std::mutex> _(owner->mutex);
+         if (MNL_LIKELY(owner->alive))
+            return owner->queue.push_back(this), __atomic_store_n(&owner->quiet, false, __ATOMIC_RELAXED), false;
+      }
+      return merge_explicit();
+   }
+# endif // # if MNL_WITH_MULTITHREADING
+
 // Signals, Exceptions, and Invocation Traces //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    MNL_IF_WITH_MT(thread_local) decltype(sig_state) pub::sig_state;
    MNL_IF_WITH_MT(thread_local) decltype(sig_trace) pub::sig_trace = []()->decltype(sig_trace){ decltype(sig_trace) res; res.reserve(100 + 1); return res; }();
@@ -112,24 +112,21 @@ namespace MNL_AUX_UUID { using namespace aux;
    MNL_S(op_round,       "Round") \
    MNL_S(op_floor,       "Floor") \
    MNL_S(op_ceil,        "Ceil") \
+   MNL_S(op_hash,        "Hash") \
 // end # define MNL_M
-   enum sym::rep: unsigned short { // see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=90324
+   enum sym::rep: unsigned { // see: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=90324
    # define MNL_S(ID, TXT) ID,
       MNL_M
    # undef MNL_S
    };
-   MNL_PRIORITY(1001) decltype(sym::dict) sym::dict{
-   # define MNL_S(ID, TXT) {TXT, ID},
-      MNL_M
-   # undef MNL_S
-   };
-   MNL_PRIORITY(1002) std::remove_extent<decltype(sym::inverse)>::type sym::inverse[lim<unsigned short>::max() + 1]{
-   # define MNL_S(ID, TXT) dict.find(TXT),
+   decltype(sym::seg0) sym::seg0{{}, {}, {
+   # define MNL_S(ID, TXT) 1,
       MNL_M
    # undef MNL_S
-   };
-   std::remove_extent<decltype(sym::rc)>::type sym::rc[lim<unsigned short>::max() + 1]{
-   # define MNL_S(ID, TXT) 1,
+   }};
+   std::remove_extent<decltype(sym::segments)>::type sym::segments[1 << (lim<unsigned>::digits - seg_bits)]{&seg0};
+   MNL_PRIORITY(1001) decltype(sym::dict) sym::dict{
+   # define MNL_S(ID, TXT) {TXT, ID},
       MNL_M
    # undef MNL_S
    };
@@ -421,11 +418,90 @@ namespace aux {
 } // namespace aux
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux { namespace {
+   MNL_INLINE inline int _order(const char *lhs, size_t lhs_size, const char *rhs, size_t rhs_size) noexcept { // lexicographic, as for box<string>
+      auto res = memcmp(lhs, rhs, std::min(lhs_size, rhs_size));
+      return res ? (res > 0) - (res < 0) : (lhs_size > rhs_size) - (lhs_size < rhs_size);
+   }
+   enum { string_slice_min = 32 }; // shorter substrings are just copied (which is about as cheap and avoids pinning large buffers)
+   enum { string_append_min = 512 }; // longer results of + on a shared String go to a growable buffer (see box<string_slice>)
+
+   val _append(const char *lhs, long lhs_size, const char *rhs, long rhs_size) { // into a fresh growable buffer, with spare capacity for later appends
+      string res; res.reserve((lhs_size + rhs_size) * 2);
+      res.append(lhs, lhs_size).append(rhs, rhs_size);
+      return string_slice{move(res), 0, lhs_size + rhs_size, true};
+   }
+}} // namespace aux::<anon>
+
    val sym::operator()(int argc, val argv[], val *argv_out) const {
       if (MNL_UNLIKELY(!argc)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       switch (argv[0].rep.tag()) {
       case 0x7FF8u: // BoxPtr (fallback)
          return static_cast<val::root *>(argv[0].rep.dat<void *>())->invoke(move(argv[0]), *this, argc - 1, argv + 1, argv_out + !!argv_out);
+      case 0xFFF8u: // short String (unboxed)
+         {  auto dat = argv[0].rep.dat<val::short_string>();
+            switch (*this) {
+            case sym::op_apply:
+               if (MNL_UNLIKELY(argc != 2) || MNL_UNLIKELY(!test<long long>(argv[1]))) break;
+               if (MNL_UNLIKELY(cast<long long>(argv[1]) < 0) || MNL_UNLIKELY(cast<long long>(argv[1]) >= dat.size))
+                  MNL_ERR(MNL_SYM("IndexOutOfRange"));
+               return dat.dat[cast<long long>(argv[1])];
+            case sym::op_size:
+               if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               return (long long)dat.size;
+            case sym::op_add:
+               if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               if (MNL_LIKELY(argv[1].rep.tag() == 0xFFF8u)) {
+                  auto rhs = argv[1].rep.dat<val::short_string>();
+                  if (MNL_UNLIKELY(dat.size + rhs.size > val::short_string_max)) return string(dat.dat, dat.size).append(rhs.dat, rhs.size);
+                  memcpy(dat.dat + dat.size, rhs.dat, rhs.size), dat.size += rhs.size;
+                  return val{decltype(val::rep){0xFFF8u, dat}};
+               }
+               if (MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
+               return string(dat.dat, dat.size) + cast<const string &>(argv[1]);
+            case sym::op_or:
+               if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               if (MNL_UNLIKELY(!test<unsigned>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+               if (MNL_UNLIKELY(cast<unsigned>(argv[1]) > lim<unsigned char>::max())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+               if (MNL_UNLIKELY(dat.size == val::short_string_max)) return string(dat.dat, dat.size) + cast<char>(argv[1]);
+               dat.dat[dat.size++] = cast<char>(argv[1]);
+               return val{decltype(val::rep){0xFFF8u, dat}};
+            case sym::op_eq:
+               if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               if (MNL_LIKELY(argv[1].rep.tag() == 0xFFF8u))
+                  { auto rhs = argv[1].rep.dat<val::short_string>(); return !memcmp(&dat, &rhs, sizeof dat); }
+               if (MNL_UNLIKELY(test<string_slice>(argv[1])))
+                  { auto &&rhs = cast<const string_slice &>(argv[1]); return !aux::_order(dat.dat, dat.size, rhs.data(), rhs.size); }
+               return  MNL_LIKELY(test<string>(argv[1])) && !aux::_order(dat.dat, dat.size, cast<const string &>(argv[1]).data(), cast<const string &>(argv[1]).size());
+            case sym::op_ne:
+               if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               if (MNL_LIKELY(argv[1].rep.tag() == 0xFFF8u))
+                  { auto rhs = argv[1].rep.dat<val::short_string>(); return  memcmp(&dat, &rhs, sizeof dat) != 0; }
+               if (MNL_UNLIKELY(test<string_slice>(argv[1])))
+                  { auto &&rhs = cast<const string_slice &>(argv[1]); return  aux::_order(dat.dat, dat.size, rhs.data(), rhs.size) != 0; }
+               return !MNL_LIKELY(test<string>(argv[1])) ||  aux::_order(dat.dat, dat.size, cast<const string &>(argv[1]).data(), cast<const string &>(argv[1]).size());
+            case sym::op_order:
+               if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               if (MNL_LIKELY(argv[1].rep.tag() == 0xFFF8u))
+                  { auto rhs = argv[1].rep.dat<val::short_string>(); return aux::_order(dat.dat, dat.size, rhs.dat, rhs.size); }
+               if (MNL_UNLIKELY(test<string_slice>(argv[1])))
+                  { auto &&rhs = cast<const string_slice &>(argv[1]); return aux::_order(dat.dat, dat.size, rhs.data(), rhs.size); }
+               if (MNL_UNLIKELY(!test<string>(argv[1]))) return argv[0].default_order(argv[1]);
+               return aux::_order(dat.dat, dat.size, cast<const string &>(argv[1]).data(), cast<const string &>(argv[1]).size());
+            case sym::op_clone: case sym::op_deep_clone: case sym::op_caret:
+               if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               return move(argv[0]);
+            case sym::op_str:
+               if (MNL_UNLIKELY(argc != 1)) break;
+               return move(argv[0]);
+            case sym::op_hash:
+               if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+               return aux::_hash(dat.dat, dat.size);
+            }
+         }
+         // anything else - transparently box and fall back
+         argv[0].box_string();
+         return static_cast<val::root *>(argv[0].rep.dat<void *>())->invoke(move(argv[0]), *this, argc - 1, argv + 1, argv_out + !!argv_out);
       case 0x7FF9u: // Nil
          switch (*this) {
          case sym::op_eq:
@@ -444,6 +520,9 @@ namespace aux {
          case sym::op_str:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             return "Nil";
+         case sym::op_hash:
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return 0;
          case sym::op_caret:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             MNL_ERR(MNL_SYM("IndirectionByNil"));
@@ -523,8 +602,11 @@ namespace aux {
          case sym::op_str:
             if (MNL_LIKELY(argc == 1)) return aux::_str(cast<long long>(argv[0]));
             if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-            if (MNL_UNLIKELY(!test<string>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+            if (MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
             return aux::_str(cast<long long>(argv[0]), cast<const string &>(argv[1]));
+         case sym::op_hash:
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return aux::_hash(cast<long long>(argv[0]));
          }
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       # define MNL_M(DAT) \
@@ -704,11 +786,14 @@ namespace aux {
          case sym::op_str: \
             if (MNL_LIKELY(argc == 1)) return aux::_str(cast<DAT>(argv[0])); \
             if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
-            if (MNL_UNLIKELY(!test<string>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch")); \
+            if (MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch")); \
             return aux::_str(cast<DAT>(argv[0]), cast<const string &>(argv[1])); \
          case sym::op_int: \
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
             return aux::_int(cast<DAT>(argv[0])); \
+         case sym::op_hash: \
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
+            return aux::_hash(cast<DAT>(argv[0])); \
          } \
          MNL_ERR(MNL_SYM("UnrecognizedOperation")); \
       // end # define MNL_M(DAT)
@@ -734,6 +819,9 @@ namespace aux {
          case sym::op_str:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             return (string)cast<const sym &>(argv[0]);
+         case sym::op_hash: // the interned text is unique while the symbol is alive
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return aux::_hash(reinterpret_cast<uintptr_t>(&(const string &)cast<const sym &>(argv[0])));
          }
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       case 0x7FFEu: // Bool/False
@@ -766,6 +854,9 @@ namespace aux {
          case sym::op_str:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             return "False";
+         case sym::op_hash:
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return 0;
          }
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       case 0x7FFFu: // Bool/True
@@ -801,6 +892,9 @@ namespace aux {
          case sym::op_str:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             return "True";
+         case sym::op_hash:
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return 1;
          }
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       case 0x7FFDu: // U32
@@ -915,18 +1009,47 @@ namespace aux {
          case op_str:
             if (MNL_LIKELY(argc == 1)) { char res[sizeof(unsigned) * 2 + sizeof "0x"]; return sprintf(res, "0x%08X", cast<unsigned>(argv[0])), res; }
             if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-            if (MNL_UNLIKELY(!test<string>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+            if (MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
             return aux::_str(cast<unsigned>(argv[0]), cast<const string &>(argv[1]));
          case op_int:
             if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
             return (long long)cast<unsigned>(argv[0]);
+         case op_hash:
+            if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            return aux::_hash(cast<unsigned>(argv[0]));
          }
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       }
    }
+   val val::_apply_short_string(int argc, val argv[], val *argv_out) && {
+      if (MNL_LIKELY(argc == 1) && MNL_LIKELY(argv[0].test<long long>())) { // String[Index]
+         auto dat = rep.dat<short_string>();
+         if (MNL_UNLIKELY(argv[0].cast<long long>() < 0) || MNL_UNLIKELY(argv[0].cast<long long>() >= dat.size))
+            MNL_ERR(MNL_SYM("IndexOutOfRange"));
+         return dat.dat[argv[0].cast<long long>()];
+      }
+      box_string();
+      return static_cast<root *>(rep.dat<void *>())->invoke(move(*this), MNL_SYM("Apply"), argc, argv, argv_out);
+   }
+# if !__clang__ // relies on the GNU C++ extension for extracting the function pointer from a bound pointer to member function
+   val aux::apply_cache::miss(const sym &target, int argc, val argv[]) const {
+      if (MNL_IF_WITH_MT(!__atomic_test_and_set(&busy, __ATOMIC_ACQUIRE)) MNL_IF_WITHOUT_MT(true)) {
+         auto root = static_cast<val::root *>(argv[0].rep.dat<void *>());
+         auto type = *reinterpret_cast<const void *const *>(root);
+         for (auto &&el: ents) if (!el.key) { // entries are never overwritten
+            el.target = (handler)(root->*&val::root::invoke);
+            MNL_IF_WITHOUT_MT(el.key = type) MNL_IF_WITH_MT(__atomic_store_n(&el.key, type, __ATOMIC_RELEASE));
+            break;
+         } else if (el.key == type) break;
+         MNL_IF_WITH_MT(__atomic_clear(&busy, __ATOMIC_RELEASE));
+      }
+      return target(argc, argv);
+   }
+# endif
    val pub::_eq(val &&lhs, val &&rhs) {
       switch (lhs.rep.tag()) {
       case 0x7FF8u: return  static_cast<val::root *>(lhs.rep.dat<void *>())->invoke(move(lhs), MNL_SYM("=="), 1, &rhs);
+      case 0xFFF8u: return  MNL_SYM("==")(args<2>{move(lhs), move(rhs)});
       case 0x7FF9u: return  test<>(rhs);
       case 0x7FFAu: return  MNL_LIKELY(test<long long>(rhs)) && cast<long long>(lhs) == cast<long long>(rhs);
       default:      return  MNL_LIKELY(test<double>(rhs)) && cast<double>(lhs) == cast<double>(rhs);
@@ -940,6 +1063,7 @@ namespace aux {
    val pub::_ne(val &&lhs, val &&rhs) {
       switch (lhs.rep.tag()) {
       case 0x7FF8u: return  static_cast<val::root *>(lhs.rep.dat<void *>())->invoke(move(lhs), MNL_SYM("<>"), 1, &rhs);
+      case 0xFFF8u: return  MNL_SYM("<>")(args<2>{move(lhs), move(rhs)});
       case 0x7FF9u: return !test<>(rhs);
       case 0x7FFAu: return !MNL_LIKELY(test<long long>(rhs)) || cast<long long>(lhs) != cast<long long>(rhs);
       default:      return !MNL_LIKELY(test<double>(rhs)) || cast<double>(lhs) != cast<double>(rhs);
@@ -954,7 +1078,7 @@ namespace aux {
       switch (lhs.rep.tag()) { \
       case 0x7FF8u: /* BoxPtr (fallback) */ \
          return static_cast<val::root *>(lhs.rep.dat<void *>())->invoke(move(lhs), MNL_SYM(SYM), 1, &rhs); \
-      case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: \
+      case 0x7FF9u: case 0xFFF8u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: \
          MNL_ERR(MNL_SYM("UnrecognizedOperation")); \
       case 0x7FFAu: /* I48 */ \
          if (MNL_UNLIKELY(!test<long long>(rhs))) MNL_ERR(MNL_SYM("TypeMismatch")); \
@@ -980,6 +1104,8 @@ namespace aux {
       switch (lhs.rep.tag()) { \
       case 0x7FF8u: /* BoxPtr (fallback) */ \
          return static_cast<val::root *>(lhs.rep.dat<void *>())->invoke(move(lhs), MNL_SYM(SYM), 1, &rhs); \
+      case 0xFFF8u: /* short String */ \
+         return MNL_SYM(SYM)(args<2>{move(lhs), move(rhs)}); \
       case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: \
          MNL_ERR(MNL_SYM("UnrecognizedOperation")); \
       case 0x7FFAu: /* I48 */ \
@@ -1003,7 +1129,7 @@ namespace aux {
       switch (rhs.rep.tag()) { \
       case 0x7FF8u: /* BoxPtr (fallback) */ \
          return static_cast<val::root *>(rhs.rep.dat<void *>())->invoke(move(rhs), MNL_SYM(SYM), 0, {}); \
-      case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: \
+      case 0x7FF9u: case 0xFFF8u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: \
          MNL_ERR(MNL_SYM("UnrecognizedOperation")); \
       case 0x7FFAu: return aux::OP(cast<long long>(rhs)); \
       default:      return aux::OP(cast<double>(rhs)); \
@@ -1035,7 +1161,7 @@ namespace aux {
       switch (rhs.rep.tag()) {
       case 0x7FF8u: // BoxPtr (fallback)
          return static_cast<val::root *>(rhs.rep.dat<void *>())->invoke(move(rhs), MNL_SYM("~"), 0, {});
-      case 0x7FF9u: case 0x7FFBu:
+      case 0x7FF9u: case 0xFFF8u: case 0x7FFBu:
          MNL_ERR(MNL_SYM("UnrecognizedOperation"));
       case 0x7FFEu: return true;
       case 0x7FFFu: return false;
@@ -1050,7 +1176,7 @@ namespace aux {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       switch (argv[0].rep.tag()) {
-      case 0x7FF8u: case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: // BoxPtr (fallback)
+      case 0x7FF8u: case 0xFFF8u: case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: // BoxPtr (fallback)
          return move(argv[safe_cast<int>(MNL_SYM("Order")(args<2>{argv[0], argv[1]})) > 0]);
       case 0x7FFAu: // I48
          if (MNL_UNLIKELY(!test<long long>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
@@ -1070,7 +1196,7 @@ namespace aux {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       switch (argv[0].rep.tag()) {
-      case 0x7FF8u: case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: // BoxPtr (fallback)
+      case 0x7FF8u: case 0xFFF8u: case 0x7FF9u: case 0x7FFBu: case 0x7FFEu: case 0x7FFFu: // BoxPtr (fallback)
          return move(argv[safe_cast<int>(MNL_SYM("Order")(args<2>{argv[0], argv[1]})) < 0]);
       case 0x7FFAu: // I48
          if (MNL_UNLIKELY(!test<long long>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
@@ -1136,6 +1262,8 @@ namespace aux {
                MNL_ERR(MNL_SYM("IndexOutOfRange"));
             if (MNL_LIKELY(rc() == 1) && MNL_LIKELY(!cast<range<>>(argv[0]).lo))
                return dat.resize(cast<range<>>(argv[0]).hi), compact(dat), move(self);
+            if (cast<range<>>(argv[0]).hi - cast<range<>>(argv[0]).lo >= string_slice_min) // no copying
+               return string_slice{move(self), cast<range<>>(argv[0]).lo, cast<range<>>(argv[0]).hi - cast<range<>>(argv[0]).lo, false};
             return string(dat.cbegin() + cast<range<>>(argv[0]).lo, dat.cbegin() + cast<range<>>(argv[0]).hi);
          }
          if (MNL_LIKELY(test<range<true>>(argv[0]))) { // String[RevRange[Low; High]] - IMDOOs: all
@@ -1155,9 +1283,9 @@ namespace aux {
                MNL_ERR(MNL_SYM("ConstraintViolation"));
             return MNL_LIKELY(rc() == 1)
                ? (dat[cast<long long>(argv[0])] = cast<char>(argv[1]), move(self))
-               : [&]()->val{ val res = dat; cast<string &>(res)[cast<long long>(argv[0])] = cast<char>(argv[1]); return res; }();
+               : [&]()->val{ auto res = dat; res[cast<long long>(argv[0])] = cast<char>(argv[1]); return move(res); }();
          }
-         if (MNL_UNLIKELY(!test<string>(argv[1])))
+         if (MNL_UNLIKELY(!argv[1].box_string()))
             MNL_ERR(MNL_SYM("TypeMismatch"));
          if (MNL_LIKELY(test<range<>>(argv[0]))) { // String.Repl[Range[Low; High]; NewString] - IMDOOs: all
             if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size()))
@@ -1181,8 +1309,19 @@ namespace aux {
          return (long long)dat.size();
       case sym::op_add: // IMDOOs: cast<const vector<val> &>(argv[0]).empty()
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>();
+            return MNL_LIKELY(rc() == 1) ? (dat.append(rhs.dat, rhs.size), move(self)) :
+               dat.size() + rhs.size >= string_append_min ? aux::_append(dat.data(), dat.size(), rhs.dat, rhs.size) : string(dat).append(rhs.dat, rhs.size);
+         }
+         if (MNL_UNLIKELY(test<string_slice>(argv[0]))) { auto &&rhs = cast<const string_slice &>(argv[0]);
+            return MNL_LIKELY(rc() == 1) ? (dat.append(rhs.data(), rhs.size), move(self)) :
+               dat.size() + rhs.size >= string_append_min ? aux::_append(dat.data(), dat.size(), rhs.data(), rhs.size) : string(dat).append(rhs.data(), rhs.size);
+         }
          if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
-         return MNL_LIKELY(rc() == 1) ? (dat += cast<const string &>(argv[0]), move(self)) : dat.empty() ? move(argv[0]) : dat + cast<const string &>(argv[0]);
+         return MNL_LIKELY(rc() == 1) ? (dat += cast<const string &>(argv[0]), move(self)) : dat.empty() ? move(argv[0]) :
+            dat.size() + cast<const string &>(argv[0]).size() >= string_append_min ?
+            aux::_append(dat.data(), dat.size(), cast<const string &>(argv[0]).data(), cast<const string &>(argv[0]).size()) :
+            dat + cast<const string &>(argv[0]);
       case sym::op_or:
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          if (MNL_UNLIKELY(!test<unsigned>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
@@ -1219,12 +1358,18 @@ namespace aux {
          return move(self);
       case sym::op_eq:
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>(); return !aux::_order(dat.data(), dat.size(), rhs.dat, rhs.size); }
+         if (MNL_UNLIKELY(test<string_slice>(argv[0]))) { auto &&rhs = cast<const string_slice &>(argv[0]); return !aux::_order(dat.data(), dat.size(), rhs.data(), rhs.size); }
          return  MNL_LIKELY(test<string>(argv[0])) && (MNL_IF_WITH_IDENT_OPT(&dat == &cast<const string &>(argv[0]) ||) dat == cast<const string &>(argv[0]));
       case sym::op_ne:
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>(); return  aux::_order(dat.data(), dat.size(), rhs.dat, rhs.size) != 0; }
+         if (MNL_UNLIKELY(test<string_slice>(argv[0]))) { auto &&rhs = cast<const string_slice &>(argv[0]); return  aux::_order(dat.data(), dat.size(), rhs.data(), rhs.size) != 0; }
          return !MNL_LIKELY(test<string>(argv[0])) || (MNL_IF_WITH_IDENT_OPT(&dat != &cast<const string &>(argv[0]) &&) dat != cast<const string &>(argv[0]));
       case sym::op_order:
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>(); return aux::_order(dat.data(), dat.size(), rhs.dat, rhs.size); }
+         if (MNL_UNLIKELY(test<string_slice>(argv[0]))) { auto &&rhs = cast<const string_slice &>(argv[0]); return aux::_order(dat.data(), dat.size(), rhs.data(), rhs.size); }
          if (MNL_UNLIKELY(!test<string>(argv[0]))) return self.default_order(argv[0]);
          MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const string &>(argv[0])) return 0;)
          for (auto lhs = dat.cbegin(), rhs = cast<const string &>(argv[0]).begin();; ++lhs, ++rhs) {
@@ -1236,10 +1381,13 @@ namespace aux {
       case sym::op_clone: case sym::op_deep_clone:
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return MNL_LIKELY(rc() == 1) ? move(self) : dat;
+      case sym::op_hash:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return aux::_hash(dat.data(), dat.size());
       case sym::op_str:
          if (MNL_LIKELY(argc == 0)) return move(self);
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
          {  auto pc = cast<const string &>(argv[0]).c_str();
             for (;;) { switch (*pc) case ' ': case '#': case '+': case '-': case '0': { ++pc; continue; } break; }
             if (isdigit(*pc) && isdigit(*++pc)) ++pc;
@@ -1253,6 +1401,79 @@ namespace aux {
       return self.default_invoke(op, argc, argv);
    }
 
+   template<> val box<string_slice>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) { // String[Range[Low; High]] (see above)
+      // A growable buffer is shared by successive results of +, each a slice that starts at 0. As long as a slice ends where the buffer currently ends
+      // (i.e., it is the most recent version) and there is spare capacity, + just appends in place - the bytes already covered by some slice never move or
+      // change, so all versions remain valid, and building a String by repeated concatenation takes amortized linear time even if the operand is shared.
+      static const auto append = [](string_slice &dat, const char *rhs, long rhs_size)->val{
+         if (dat.growable) {
+            MNL_IF_WITH_MT(static std::mutex mutex; std::lock_guard<std::mutex> lock(mutex);)
+            auto &buf = cast<string &>(dat.base);
+            if (MNL_LIKELY(dat.lo + dat.size == (long)buf.size()) && MNL_LIKELY(buf.size() + rhs_size <= buf.capacity()))
+               return buf.append(rhs, rhs_size), string_slice{dat.base, dat.lo, dat.size + rhs_size, true};
+         }
+         return aux::_append(dat.data(), dat.size, rhs, rhs_size);
+      };
+      switch (op) {
+      case sym::op_apply:
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<long long>(argv[0]))) { // String[Index]
+            if (MNL_UNLIKELY(cast<long long>(argv[0]) < 0) || MNL_UNLIKELY(cast<long long>(argv[0]) >= dat.size))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            return dat.data()[cast<long long>(argv[0])];
+         }
+         if (MNL_LIKELY(test<range<>>(argv[0]))) { // String[Range[Low; High]]
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            if (cast<range<>>(argv[0]).hi - cast<range<>>(argv[0]).lo >= string_slice_min)
+               return string_slice{dat.base, dat.lo + cast<range<>>(argv[0]).lo, cast<range<>>(argv[0]).hi - cast<range<>>(argv[0]).lo, dat.growable};
+            return string(dat.data() + cast<range<>>(argv[0]).lo, dat.data() + cast<range<>>(argv[0]).hi);
+         }
+         break;
+      case sym::op_size:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return (long long)dat.size;
+      case sym::op_add:
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>(); return append(dat, rhs.dat, rhs.size); }
+         if (MNL_UNLIKELY(test<string_slice>(argv[0])))
+            { auto &&rhs = cast<const string_slice &>(argv[0]); return append(dat, rhs.data(), rhs.size); }
+         if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         return append(dat, cast<const string &>(argv[0]).data(), cast<const string &>(argv[0]).size());
+      case sym::op_eq:
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) return false; // never that short
+         if (MNL_LIKELY(test<string_slice>(argv[0])))
+            { auto &&rhs = cast<const string_slice &>(argv[0]); return !aux::_order(dat.data(), dat.size, rhs.data(), rhs.size); }
+         return  MNL_LIKELY(test<string>(argv[0])) && !aux::_order(dat.data(), dat.size, cast<const string &>(argv[0]).data(), cast<const string &>(argv[0]).size());
+      case sym::op_ne:
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) return true;
+         if (MNL_LIKELY(test<string_slice>(argv[0])))
+            { auto &&rhs = cast<const string_slice &>(argv[0]); return  aux::_order(dat.data(), dat.size, rhs.data(), rhs.size) != 0; }
+         return !MNL_LIKELY(test<string>(argv[0])) ||  aux::_order(dat.data(), dat.size, cast<const string &>(argv[0]).data(), cast<const string &>(argv[0]).size());
+      case sym::op_order:
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(argv[0].rep.tag() == 0xFFF8u)) { auto rhs = argv[0].rep.dat<val::short_string>(); return aux::_order(dat.data(), dat.size, rhs.dat, rhs.size); }
+         if (MNL_LIKELY(test<string_slice>(argv[0])))
+            { auto &&rhs = cast<const string_slice &>(argv[0]); return aux::_order(dat.data(), dat.size, rhs.data(), rhs.size); }
+         if (MNL_UNLIKELY(!test<string>(argv[0]))) return self.default_order(argv[0]);
+         return aux::_order(dat.data(), dat.size, cast<const string &>(argv[0]).data(), cast<const string &>(argv[0]).size());
+      case sym::op_hash:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return aux::_hash(dat.data(), dat.size);
+      case sym::op_caret:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return move(self);
+      case sym::op_str:
+         if (MNL_UNLIKELY(argc != 0)) break;
+         return move(self);
+      }
+      // anything else (including updates) - materialize and fall back
+      self.box_string();
+      return static_cast<root *>(self.rep.dat<void *>())->invoke(move(self), op, argc, argv, argv_out);
+   }
+
    template<> val box<vector<val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) { // one instance of List is Array
       static const auto compact = [](vector<val> &dat)
          { if (MNL_UNLIKELY(dat.capacity() > dat.size() * 2)) dat.shrink_to_fit(); };
@@ -1429,6 +1650,9 @@ namespace aux {
       case sym::op_deep_clone:
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return [this]()->val{ val res = dat; for (auto &&el: cast<vector<val> &>(res)) el = MNL_SYM("DeepClone")(move(el)); return res; }();
+      case sym::op_hash:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = dat.size(); for (auto &&el: dat) res = aux::_hash_combine(res, safe_cast<long long>(op(el))); return res; }
       }
       return self.default_invoke(op, argc, argv);
    }
@@ -1566,6 +1790,12 @@ namespace aux {
       case sym::op_deep_clone:
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return [this]()->val{ val res = *this; for (auto &&el: cast<_record &>(res).items) el = MNL_SYM("DeepClone")(move(el)); return res; }();
+      case sym::op_hash:
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = aux::_hash(reinterpret_cast<uintptr_t>(&descr.items()));
+            for (auto &&el: items) res = aux::_hash_combine(res, safe_cast<long long>(op(el)));
+            return res;
+         }
       }
       return self.default_invoke(op, argc, argv);
    }
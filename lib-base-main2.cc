@@ -23,7 +23,7 @@
 namespace MNL_AUX_UUID { using namespace aux;
    namespace aux {
       using std::make_shared; // <memory>
-      using std::deque; using std::list;
+      using std::deque;
    }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,157 @@ namespace aux {
    code optimize(expr_att);
 } // namespace aux
 
+// Lazy Views //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux { namespace {
+   class lazy_view { // Mapped[View; Proc], Filtered[View; Proc], Taken[View; Count], Zipped[View; ...], Chained[View; ...]
+   public:
+      enum { mapped, filtered, taken, zipped, chained };
+      int kind; vector<val> base; val proc; long long count;
+   public:
+      class cursor { // pull-based iteration state, one per traversal; a chain of views is traversed in a single pass
+      public:
+         virtual ~cursor() = default;
+         virtual bool next(val &) = 0; // false on exhaustion
+      };
+      static std::unique_ptr<cursor> open(const val &);
+   private:
+      MNL_INLINE inline val invoke(val &&, const sym &, int, val [], val *) const;
+      friend box<lazy_view>;
+   };
+
+   std::unique_ptr<lazy_view::cursor> lazy_view::open(const val &view) {
+      if (MNL_LIKELY(test<lazy_view>(view))) {
+         auto &&dat = cast<const lazy_view &>(view);
+         switch (dat.kind) {
+         case mapped:
+            {  struct cur: cursor { std::unique_ptr<cursor> base; val proc;
+                  cur(std::unique_ptr<cursor> &&base, const val &proc): base(move(base)), proc(proc) {}
+                  bool next(val &res) override { if (MNL_UNLIKELY(!base->next(res))) return false; res = proc(move(res)); return true; }
+               };
+               return std::unique_ptr<cursor>(new cur{open(dat.base.front()), dat.proc});
+            }
+         case filtered:
+            {  struct cur: cursor { std::unique_ptr<cursor> base; val proc;
+                  cur(std::unique_ptr<cursor> &&base, const val &proc): base(move(base)), proc(proc) {}
+                  bool next(val &res) override { while (MNL_LIKELY(base->next(res))) if (safe_cast<bool>(proc(res))) return true; return false; }
+               };
+               return std::unique_ptr<cursor>(new cur{open(dat.base.front()), dat.proc});
+            }
+         case taken:
+            {  struct cur: cursor { std::unique_ptr<cursor> base; long long count;
+                  cur(std::unique_ptr<cursor> &&base, long long count): base(move(base)), count(count) {}
+                  bool next(val &res) override { return MNL_LIKELY(count) && (--count, base->next(res)); }
+               };
+               return std::unique_ptr<cursor>(new cur{open(dat.base.front()), dat.count});
+            }
+         case zipped:
+            {  struct cur: cursor { vector<std::unique_ptr<cursor>> base;
+                  bool next(val &res) override {
+                     vector<val> tuple(base.size());
+                     for (size_t sn = 0; sn < base.size(); ++sn) if (MNL_UNLIKELY(!base[sn]->next(tuple[sn]))) return false;
+                     res = move(tuple); return true;
+                  }
+               };
+               std::unique_ptr<cur> res(new cur); res->base.reserve(dat.base.size());
+               for (auto &&el: dat.base) res->base.push_back(open(el));
+               return move(res);
+            }
+         case chained:
+            {  struct cur: cursor { val view; size_t sn = 0; std::unique_ptr<cursor> base;
+                  cur(const val &view): view(view) {}
+                  bool next(val &res) override {
+                     for (auto &&dat = cast<const lazy_view &>(view).base;;) {
+                        if (MNL_LIKELY(base) && MNL_LIKELY(base->next(res))) return true;
+                        if (MNL_UNLIKELY(sn == dat.size())) return false;
+                        base = open(dat[sn++]);
+                     }
+                  }
+               };
+               return std::unique_ptr<cursor>(new cur{view});
+            }
+         }
+      }
+      struct range_cur: cursor { long long lo, hi;
+         range_cur(long long lo, long long hi): lo(lo), hi(hi) {}
+         bool next(val &res) override { if (MNL_UNLIKELY(lo == hi)) return false; res = lo++; return true; }
+      };
+      struct rev_range_cur: cursor { long long lo, hi;
+         rev_range_cur(long long lo, long long hi): lo(lo), hi(hi) {}
+         bool next(val &res) override { if (MNL_UNLIKELY(lo == hi)) return false; res = --hi; return true; }
+      };
+      struct array_cur: cursor { val base; size_t sn = 0;
+         array_cur(val &&base): base(move(base)) {}
+         bool next(val &res) override
+            { if (MNL_UNLIKELY(sn == cast<const vector<val> &>(base).size())) return false; res = cast<const vector<val> &>(base)[sn++]; return true; }
+      };
+      struct string_cur: cursor { val base; size_t sn = 0;
+         string_cur(val &&base): base(move(base)) {}
+         bool next(val &res) override
+            { if (MNL_UNLIKELY(sn == cast<const string &>(base).size())) return false; res = cast<const string &>(base)[sn++]; return true; }
+      };
+      if (MNL_LIKELY(test<range<>>(view)))     return std::unique_ptr<cursor>(new range_cur{cast<const range<> &>(view).lo, cast<const range<> &>(view).hi});
+      if (MNL_LIKELY(test<range<true>>(view))) return std::unique_ptr<cursor>(new rev_range_cur{cast<const range<true> &>(view).lo, cast<const range<true> &>(view).hi});
+      if (MNL_LIKELY(test<vector<val>>(view))) return std::unique_ptr<cursor>(new array_cur{val(view)});
+      // else
+      auto elems = MNL_SYM("Elems")(view);
+      if (MNL_LIKELY(test<vector<val>>(elems))) return std::unique_ptr<cursor>(new array_cur{move(elems)});
+      if (MNL_LIKELY(test<string>(elems)))      return std::unique_ptr<cursor>(new string_cur{move(elems)});
+      if (MNL_LIKELY(test<range<>>(elems)))     return std::unique_ptr<cursor>(new range_cur{cast<const range<> &>(elems).lo, cast<const range<> &>(elems).hi});
+      if (MNL_LIKELY(test<range<true>>(elems))) return std::unique_ptr<cursor>(new rev_range_cur{cast<const range<true> &>(elems).lo, cast<const range<true> &>(elems).hi});
+      // else
+      struct indexed_cur: cursor { val base; long long sn = 0, size;
+         indexed_cur(val &&base): base(move(base)) {
+            size = safe_cast<long long>(MNL_SYM("Size")(this->base));
+            if (MNL_UNLIKELY(size < 0)) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         }
+         bool next(val &res) override {
+            if (MNL_UNLIKELY(sn == size)) return false;
+            try { res = base(sn++); }
+            catch (decltype(::mnl::sig_state) &sig) { if (sig.first == MNL_SYM("EndOfData")) return size = sn, false; throw; }
+            return true;
+         }
+      };
+      return std::unique_ptr<cursor>(new indexed_cur{move(elems)});
+   }
+
+   MNL_INLINE inline val lazy_view::invoke(val &&self, const sym &op, int argc, val argv[], val *) const {
+      switch (MNL_DISP("Size", "Elems", "^")[op]) {
+      case 1: // Size
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = 0; val el; for (auto cur = open(self); cur->next(el);) ++res; return res; }
+      case 2: case 3: // Elems, ^ - materialization
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  vector<val> res; val el; for (auto cur = open(self); cur->next(el);) res.push_back(move(el)); return res; }
+      case 0:
+         return self.default_invoke(op, argc, argv);
+      }
+   }
+
+   template<int Kind> class proc_LazyView {
+      MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+         if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+         lazy_view res{Kind};
+         switch (Kind) {
+         case lazy_view::mapped: case lazy_view::filtered: // Mapped[View; Proc], Filtered[View; Proc]
+            if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            res.base.push_back(move(argv[0])), res.proc = move(argv[1]);
+            return move(res);
+         case lazy_view::taken: // Taken[View; Count]
+            if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            if (MNL_UNLIKELY(!test<long long>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+            if (MNL_UNLIKELY(cast<long long>(argv[1]) < 0)) MNL_ERR(MNL_SYM("ConstraintViolation"));
+            res.base.push_back(move(argv[0])), res.count = cast<long long>(argv[1]);
+            return move(res);
+         default: // Zipped[View; ...], Chained[View; ...]
+            if (MNL_UNLIKELY(argc < 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+            res.base.reserve(argc); for (int sn = 0; sn < argc; ++sn) res.base.push_back(move(argv[sn]));
+            return move(res);
+         }
+      }
+      friend box<proc_LazyView>;
+   };
+}} // namespace aux::<unnamed>
+
 namespace aux { namespace {
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -85,11 +236,21 @@ namespace aux { namespace {
          if (form.size() >= 6); else goto opt2;
          if (form[2] == MNL_SYM("then")); else goto opt2;
          if (form[4] == MNL_SYM("else")); else goto opt2;
-         return optimize(expr_ifelse<>{compile_rval(form[1], _loc), compile_rval(form[3], _loc), compile_rval(form + 5, _loc), _loc});
+         {  auto tail = &form == tail_form; // tail position of a procedure body (for both branches)
+            auto cond = compile_rval(form[1], _loc);
+            if (tail) tail_form = &form[3]; auto body1 = compile_rval(form[3], _loc);
+            if (tail) tail_form = &form[form.size() - 1]; auto body2 = compile_rval(form + 5, _loc);
+            val value; if (match_lit(cond, value) && test<bool>(value)) return cast<bool>(value) ? move(body1) : move(body2); // partial evaluation
+            return optimize(expr_ifelse<>{move(cond), move(body1), move(body2), _loc});
+         }
       opt2: // {if C then B; B; ...}
          if (form.size() >= 4); else goto opt3;
          if (form[2] == MNL_SYM("then")); else goto opt3;
-         return optimize(expr_if<>{compile_rval(form[1], _loc), compile_rval(form + 3, _loc), _loc});
+         {  auto cond = compile_rval(form[1], _loc), body = compile_rval(form + 3, _loc);
+            val value; if (match_lit(cond, value) && test<bool>(value)) // partial evaluation
+               return cast<bool>(value) ? expr_seq{move(body), make_lit(val{})} : make_lit(val{});
+            return optimize(expr_if<>{move(cond), move(body), _loc});
+         }
       opt3:
          err_compile("invalid form", _loc);
       }
@@ -110,7 +271,8 @@ namespace aux { namespace {
    };
 
    class comp_while { MNL_NONVALUE()
-      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) {
+      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) { return hoist_loop(compile_loop, form, _loc); }
+      static code compile_loop(const form &form, const loc &_loc) {
       opt1: // {while C do B; B; ...}
          if (form.size() >= 4); else goto opt2;
          if (form[2] == MNL_SYM("do")); else goto opt2;
@@ -121,7 +283,8 @@ namespace aux { namespace {
    };
 
    class comp_repeat { MNL_NONVALUE()
-      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) {
+      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) { return hoist_loop(compile_loop, form, _loc); }
+      static code compile_loop(const form &form, const loc &_loc) {
       opt1: // {repeat N do B; B; ...}
          if (form.size() >= 4); else goto opt2;
          if (form[2] == MNL_SYM("do")); else goto opt2;
@@ -163,6 +326,7 @@ namespace aux { namespace {
          if (tmp_cnt == lim<decltype(tmp_cnt)>::max()) MNL_ERR(MNL_SYM("LimitExceeded"));
          {  auto key = compile_rval(form[1], _loc);
             auto overriden_ent = symtab[cast<const sym &>(form[3])]; symtab.update(cast<const sym &>(form[3]), expr_tmp{tmp_cnt++});
+            if (tmp_cnt > tmp_max) tmp_max = tmp_cnt;
             auto inserted_tmp_id = tmp_ids.insert(cast<const sym &>(form[3])).second;
             auto trap = compile_rval(form[5], _loc);
             if (inserted_tmp_id) tmp_ids.erase(cast<const sym &>(form[3]));
@@ -194,7 +358,8 @@ namespace aux { namespace {
    };
 
    class comp_for { MNL_NONVALUE()
-      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) {
+      MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) { return hoist_loop(compile_loop, form, _loc); }
+      static code compile_loop(const form &form, const loc &_loc) {
       opt1: // {for {I = V; I = V; ...} do B; B; ...}
          {  if (form.size() >= 4); else goto opt2;
             if (form[1].is_list() && form[1].size() >= 1); else goto opt2;
@@ -211,6 +376,7 @@ namespace aux { namespace {
             deque<code> overriden_ents;
             for (auto &&el: form[1]) overriden_ents.push_back(symtab[cast<const sym &>(el[1])]),
                symtab.update(cast<const sym &>(el[1]), expr_tmp{tmp_cnt++});
+            if (tmp_cnt > tmp_max) tmp_max = tmp_cnt;
             vector<sym> inserted_tmp_ids;
             for (auto &&el: form[1]) if (tmp_ids.insert(cast<const sym &>(el[1])).second) inserted_tmp_ids.push_back(cast<const sym &>(el[1]));
 
@@ -225,37 +391,41 @@ namespace aux { namespace {
                   code view, body; loc _loc;
                   MNL_INLINE val execute(bool fast_sig) const {
                      auto view = this->view.execute();
-                     tmp_stk.push_back({});
-                     struct _ { MNL_INLINE ~_() { tmp_stk.pop_back(); } } _;
+                     tmp_stk.alloc(1);
+                     struct _ { MNL_INLINE ~_() { tmp_stk.pop(); } } _;
                      MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk; auto &sig_state = mnl::sig_state;)
                      if (MNL_UNLIKELY(test<range<>>(view)))
                      for (auto lo = cast<const range<> &>(view).lo, hi = cast<const range<> &>(view).hi;;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() =  lo++, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] =  lo++, body.execute(fast_sig), sig_state.first )) return {};
                      if (MNL_UNLIKELY(test<range<true>>(view)))
                      for (auto lo = cast<const range<true> &>(view).lo, hi = cast<const range<true> &>(view).hi;;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() =  --hi, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] =  --hi, body.execute(fast_sig), sig_state.first )) return {};
                      if (MNL_UNLIKELY(test<vector<val>>(view)))
                      for (auto lo = cast<const vector<val> &>(view).begin(), hi = cast<const vector<val> &>(view).end();;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() = *lo++, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] = *lo++, body.execute(fast_sig), sig_state.first )) return {};
+                     if (MNL_UNLIKELY(test<lazy_view>(view))) // fused traversal of a chain of lazy views
+                     for (auto cur = lazy_view::open(view);;) { val el;
+                        if (!MNL_LIKELY(cur->next(el)) || MNL_UNLIKELY( tmp_stk.top[-1] = move(el), body.execute(fast_sig), sig_state.first )) return {};
+                     }
                      // else
                      view = MNL_SYM("Elems")(_loc, move(view));
                      if (MNL_UNLIKELY(test<vector<val>>(view)))
                      for (auto lo = cast<const vector<val> &>(view).begin(), hi = cast<const vector<val> &>(view).end();;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() = *lo++, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] = *lo++, body.execute(fast_sig), sig_state.first )) return {};
                      if (MNL_UNLIKELY(test<string>(view)))
                      for (auto lo = cast<const string &>(view).begin(), hi = cast<const string &>(view).end();;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() = *lo++, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] = *lo++, body.execute(fast_sig), sig_state.first )) return {};
                      if (MNL_UNLIKELY(test<range<>>(view)))
                      for (auto lo = cast<const range<> &>(view).lo, hi = cast<const range<> &>(view).hi;;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() =  lo++, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] =  lo++, body.execute(fast_sig), sig_state.first )) return {};
                      if (MNL_UNLIKELY(test<range<true>>(view)))
                      for (auto lo = cast<const range<true> &>(view).lo, hi = cast<const range<true> &>(view).hi;;)
-                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.back() =  --hi, body.execute(fast_sig), sig_state.first )) return {};
+                        if (!MNL_LIKELY(lo != hi) || MNL_UNLIKELY( tmp_stk.top[-1] =  --hi, body.execute(fast_sig), sig_state.first )) return {};
                      // else
                      auto hi = safe_cast<long long>(_loc, MNL_SYM("Size")(_loc, view));
                      if (MNL_UNLIKELY(hi < 0)) MNL_ERR_LOC(_loc, MNL_SYM("ConstraintViolation"));
                      for (long long lo = 0; lo < hi; ++lo) {
-                        try { tmp_stk.back() = view(_loc, lo); }
+                        try { tmp_stk.top[-1] = view(_loc, lo); }
                         catch (decltype(::mnl::sig_state) &sig) { if (sig.first == MNL_SYM("EndOfData")) return {}; throw; }
                         if (MNL_UNLIKELY( body.execute(fast_sig), sig_state.first )) return {};
                      }
@@ -275,11 +445,11 @@ namespace aux { namespace {
                         if (MNL_UNLIKELY(_size < 0)) MNL_ERR_LOC(_loc, MNL_SYM("ConstraintViolation"));
                         if (MNL_UNLIKELY(_size < size)) size = _size;
                      }
-                     tmp_stk.resize(tmp_stk.size() + 2);
-                     struct _ { MNL_INLINE ~_() { tmp_stk.pop_back(), tmp_stk.pop_back(); } } _;
+                     tmp_stk.alloc(2);
+                     struct _ { MNL_INLINE ~_() { tmp_stk.pop(2); } } _;
                      MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk; auto &sig_state = mnl::sig_state;)
                      for (long long sn = 0; sn < size; ++sn) {
-                        try { tmp_stk.end()[-2] = view0(_loc, sn), tmp_stk.end()[-1] = view1(_loc, sn); }
+                        try { tmp_stk.top[-2] = view0(_loc, sn), tmp_stk.top[-1] = view1(_loc, sn); }
                         catch (decltype(::mnl::sig_state) &sig) { if (sig.first == MNL_SYM("EndOfData")) return {}; throw; }
                         if (MNL_UNLIKELY( body.execute(fast_sig), sig_state.first )) return {};
                      }
@@ -300,11 +470,11 @@ namespace aux { namespace {
                         if (MNL_UNLIKELY(_size < 0)) MNL_ERR_LOC(_loc, MNL_SYM("ConstraintViolation"));
                         if (MNL_UNLIKELY(_size < size)) size = _size;
                      }
-                     tmp_stk.resize(tmp_stk.size() + view.size());
-                     struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _{(int)view.size()};
+                     tmp_stk.alloc((int)view.size());
+                     struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _{(int)view.size()};
                      MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk; auto &sig_state = mnl::sig_state;)
                      for (long long sn1 = 0; sn1 < size; ++sn1) {
-                        try { for (int sn2 = 0; sn2 < (int)view.size(); ++sn2) (tmp_stk.end() - view.size())[sn2] = view[sn2](_loc, sn1); }
+                        try { for (int sn2 = 0; sn2 < (int)view.size(); ++sn2) (tmp_stk.top - view.size())[sn2] = view[sn2](_loc, sn1); }
                         catch (decltype(::mnl::sig_state) &sig) { if (sig.first == MNL_SYM("EndOfData")) return {}; throw; }
                         if (MNL_UNLIKELY( body.execute(fast_sig), sig_state.first )) return {};
                      }
@@ -329,7 +499,8 @@ namespace aux { namespace {
          }
          {  if (form[3].size() > lim<unsigned char>::max()) MNL_ERR(MNL_SYM("LimitExceeded"));
          }
-         {  auto key = compile_rval(form[1], _loc);
+         {  auto tail = &form == tail_form; // tail position of a procedure body (for all arms)
+            auto key = compile_rval(form[1], _loc);
 
             set<sym> descr; vector<code> arms;
 
@@ -343,7 +514,9 @@ namespace aux { namespace {
             tmp_cnt = move(saved_tmp_cnt);
             for (auto &&el: tmp_ids) symtab.update(el, move(saved_tmp_ents.front())), saved_tmp_ents.pop_front();
 
-            {  sym::tab<> tab; for (auto &&el: form[3]) tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
+            {  sym::tab<> tab; for (auto &&el: form[3])
+                  if (tail) tail_form = &el[2], tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
+                  else tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
                arms.reserve(descr.size()); for (auto &&el: descr) arms.push_back(tab[el]);
             }
 
@@ -369,6 +542,7 @@ namespace aux { namespace {
                MNL_INLINE bool _is_lvalue() const noexcept
                   { for (auto &&el: arms) if (!el.is_lvalue()) return false; return else_arm.is_lvalue(); }
             };
+            if (tail) tail_form = &form[form.size() - 1];
             return expr{move(key), move(descr), move(arms), compile_rval(form + 5, _loc)};
          }
       opt2: // {case V of K = B; K = B; ...}
@@ -378,7 +552,8 @@ namespace aux { namespace {
          }
          {  if (form.size() - 3 > lim<unsigned char>::max()) MNL_ERR(MNL_SYM("LimitExceeded"));
          }
-         {  auto key = compile_rval(form[1], _loc);
+         {  auto tail = &form == tail_form; // tail position of a procedure body (for all arms)
+            auto key = compile_rval(form[1], _loc);
 
             set<sym> descr; vector<code> arms;
 
@@ -392,7 +567,9 @@ namespace aux { namespace {
             tmp_cnt = move(saved_tmp_cnt);
             for (auto &&el: tmp_ids) symtab.update(el, move(saved_tmp_ents.front())), saved_tmp_ents.pop_front();
 
-            {  sym::tab<> tab; for (auto &&el: form + 3) tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
+            {  sym::tab<> tab; for (auto &&el: form + 3)
+                  if (tail) tail_form = &el[2], tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
+                  else tab.update(move(keys.front()), compile_rval(el[2], _loc)), keys.pop_front();
                arms.reserve(descr.size()); for (auto &&el: descr) arms.push_back(tab[el]);
             }
 
@@ -446,46 +623,24 @@ namespace aux { namespace {
          {  deque<code> saved_tmp_ents;
             for (auto &&el: tmp_ids) saved_tmp_ents.push_back(symtab[el]), symtab.update(el, {});
             auto saved_tmp_cnt = move(tmp_cnt); tmp_cnt = 0;
+            auto saved_tmp_max = move(tmp_max); tmp_max = 0;
             auto saved_tmp_ids = move(tmp_ids); tmp_ids.clear();
             deque<code> overriden_ents;
             for (auto &&el: form[1]) overriden_ents.push_back(symtab[cast<const sym &>(el)]),
                symtab.update(cast<const sym &>(el), expr_tmp{tmp_cnt++});
+            tmp_max = tmp_cnt;
             for (auto &&el: form[1]) tmp_ids.insert(cast<const sym &>(el));
 
-            auto body = compile_rval(form + 3, _loc);
+            struct _ { decltype(tail_form) saved; MNL_INLINE ~_() { tail_form = saved; } } _{tail_form}; tail_form = &form[form.size() - 1];
+            auto body = compile_rval(form + 3, _loc); int frame_size = tmp_max;
 
             for (auto &&el: form[1]) symtab.update(cast<const sym &>(el), move(overriden_ents.front())), overriden_ents.pop_front();
             tmp_ids = move(saved_tmp_ids);
+            tmp_max = move(saved_tmp_max);
             tmp_cnt = move(saved_tmp_cnt);
             for (auto &&el: tmp_ids) symtab.update(el, move(saved_tmp_ents.front())), saved_tmp_ents.pop_front();
 
-            switch (form[1].size()) {
-            # define MNL_M1(ARG_COUNT) \
-               MNL_INLINE val invoke(val &&self, const sym &op, int argc, val argv[], val *) { \
-                  stk_check(); \
-                  if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv); \
-                  if (MNL_UNLIKELY(argc != ARG_COUNT)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
-                  struct _ { \
-                     decltype(tmp_frm) saved_tmp_frm; int sn; \
-                     MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); tmp_frm = move(saved_tmp_frm); } \
-                  } _; \
-                  _.saved_tmp_frm = move(tmp_frm), tmp_frm = tmp_stk.size(); \
-                  for (_.sn = 0; _.sn < ARG_COUNT; ++_.sn) tmp_stk.push_back(move(argv[_.sn])); \
-                  return body.execute(); \
-               } \
-            // end # define MNL_M1(ARG_COUNT)
-               {  struct proc { const int arg_count; code body; MNL_M1(arg_count) };
-               default: return optimize(expr_lit<>{proc{(int)form[1].size(), move(body)}});
-               }
-            # define MNL_M2(ARG_COUNT) \
-               {  struct proc { code body; MNL_M1(ARG_COUNT) }; \
-               case ARG_COUNT: return optimize(expr_lit<>{proc{move(body)}}); \
-               } \
-            // end # define MNL_M2(ARG_COUNT)
-               MNL_M2(0) MNL_M2(1) MNL_M2(2) MNL_M2(3) MNL_M2(4) MNL_M2(5) MNL_M2(6)
-            # undef MNL_M2
-            # undef MNL_M1
-            }
+            return optimize(expr_lit<>{proc{(int)form[1].size(), frame_size, move(body)}});
          }
       opt2: // {proc {I,I?; ...} as B; B; ...}
          {  if (form.size() >= 4); else goto opt3;
@@ -502,42 +657,25 @@ namespace aux { namespace {
          {  deque<code> saved_tmp_ents;
             for (auto &&el: tmp_ids) saved_tmp_ents.push_back(symtab[el]), symtab.update(el, {});
             auto saved_tmp_cnt = move(tmp_cnt); tmp_cnt = 0;
+            auto saved_tmp_max = move(tmp_max); tmp_max = 0;
             auto saved_tmp_ids = move(tmp_ids); tmp_ids.clear();
             deque<code> overriden_ents;
             for (auto &&el: form[1]) overriden_ents.push_back(symtab[cast<const sym &>(test<sym>(el) ? el : el[1])]),
                symtab.update(cast<const sym &>(test<sym>(el) ? el : el[1]), expr_tmp{tmp_cnt++});
+            tmp_max = tmp_cnt;
             for (auto &&el: form[1]) tmp_ids.insert(cast<const sym &>(test<sym>(el) ? el : el[1]));
 
             vector<unsigned char> mode; for (auto &&el: form[1]) mode.push_back(!test<sym>(el));
-            auto body = compile_rval(form + 3, _loc);
+            struct _ { decltype(tail_form) saved; MNL_INLINE ~_() { tail_form = saved; } } _{tail_form}; tail_form = &form[form.size() - 1];
+            auto body = compile_rval(form + 3, _loc); int frame_size = tmp_max;
 
             for (auto &&el: form[1]) symtab.update(cast<const sym &>(test<sym>(el) ? el : el[1]), move(overriden_ents.front())), overriden_ents.pop_front();
             tmp_ids = move(saved_tmp_ids);
+            tmp_max = move(saved_tmp_max);
             tmp_cnt = move(saved_tmp_cnt);
             for (auto &&el: tmp_ids) symtab.update(el, move(saved_tmp_ents.front())), saved_tmp_ents.pop_front();
 
-            struct proc {
-               vector<unsigned char> mode; code body;
-            public:
-               MNL_INLINE val invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
-                  stk_check();
-                  if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
-                  if (MNL_UNLIKELY(argc != (int)mode.size())) MNL_ERR(MNL_SYM("InvalidInvocation"));
-                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = tmp_stk.size();
-                  int sn; for (sn = 0; sn < argc; ++sn) tmp_stk.push_back(move(argv[sn]));
-                  try {
-                     auto res = body.execute();
-                     if (!argv_out) for (; sn; --sn) tmp_stk.pop_back();
-                        else for (; sn; tmp_stk.pop_back()) if (MNL_UNLIKELY(mode[--sn])) argv_out[sn].swap(tmp_stk.back());
-                     tmp_frm = move(saved_tmp_frm);
-                     return res;
-                  } catch (...) {
-                     while (sn--) tmp_stk.pop_back(); tmp_frm = move(saved_tmp_frm);
-                     throw;
-                  }
-               }
-            };
-            return optimize(expr_lit<>{proc{move(mode), move(body)}});
+            return optimize(expr_lit<>{proc{(int)form[1].size(), frame_size, move(body), move(mode)}});
          }
       opt3:
          err_compile("invalid form", _loc);
@@ -560,9 +698,11 @@ namespace aux { namespace {
          {  deque<code> overriden_ents;
             for (auto &&el: form[1]) overriden_ents.push_back(symtab[cast<const sym &>(el)]),
                symtab.update(cast<const sym &>(el), expr_tmp{tmp_cnt++});
+            if (tmp_cnt > tmp_max) tmp_max = tmp_cnt;
             vector<sym> inserted_tmp_ids;
             for (auto &&el: form[1]) if (tmp_ids.insert(cast<const sym &>(el)).second) inserted_tmp_ids.push_back(cast<const sym &>(el));
 
+            if (&form == tail_form) tail_form = &form[form.size() - 1]; // tail position of a procedure body
             auto body = compile_rval(form + 3, _loc);
 
             for (auto &&el: inserted_tmp_ids) tmp_ids.erase(move(el));
@@ -573,18 +713,18 @@ namespace aux { namespace {
             case 0: return move(body);
             # define MNL_M1(VAR_COUNT) \
                MNL_INLINE val execute(bool fast_sig) const { \
-                  tmp_stk.resize(tmp_stk.size() + VAR_COUNT); \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _{VAR_COUNT}; \
+                  tmp_stk.alloc(VAR_COUNT); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _{VAR_COUNT}; \
                   return body.execute(fast_sig); \
                } \
                MNL_INLINE void exec_in(val &&value) const { \
-                  tmp_stk.resize(tmp_stk.size() + VAR_COUNT); \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _{VAR_COUNT}; \
+                  tmp_stk.alloc(VAR_COUNT); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _{VAR_COUNT}; \
                   body.exec_in(move(value)); \
                } \
                MNL_INLINE val exec_out() const { \
-                  tmp_stk.resize(tmp_stk.size() + VAR_COUNT); \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _{VAR_COUNT}; \
+                  tmp_stk.alloc(VAR_COUNT); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _{VAR_COUNT}; \
                   return body.exec_out(); \
                } \
             // end # define MNL_M1(VAR_COUNT)
@@ -617,9 +757,11 @@ namespace aux { namespace {
             deque<code> overriden_ents;
             for (auto &&el: form[1]) overriden_ents.push_back(symtab[cast<const sym &>(el[1])]),
                symtab.update(cast<const sym &>(el[1]), expr_tmp{tmp_cnt++});
+            if (tmp_cnt > tmp_max) tmp_max = tmp_cnt;
             vector<sym> inserted_tmp_ids;
             for (auto &&el: form[1]) if (tmp_ids.insert(cast<const sym &>(el[1])).second) inserted_tmp_ids.push_back(cast<const sym &>(el[1]));
 
+            if (&form == tail_form) tail_form = &form[form.size() - 1]; // tail position of a procedure body
             auto body = compile_rval(form + 3, _loc);
 
             for (auto &&el: inserted_tmp_ids) tmp_ids.erase(move(el));
@@ -629,18 +771,18 @@ namespace aux { namespace {
             switch (form[1].size()) {
             # define MNL_M1(VAR_COUNT) \
                MNL_INLINE val execute(bool fast_sig) const { \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _; \
-                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push_back(init[_.sn].execute()); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _; \
+                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push(init[_.sn].execute()); \
                   return body.execute(fast_sig); \
                } \
                MNL_INLINE void exec_in(val &&value) const { \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _; \
-                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push_back(init[_.sn].execute()); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _; \
+                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push(init[_.sn].execute()); \
                   body.exec_in(move(value)); \
                } \
                MNL_INLINE val exec_out() const { \
-                  struct _ { int sn; MNL_INLINE ~_() { for (; sn; --sn) tmp_stk.pop_back(); } } _; \
-                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push_back(init[_.sn].execute()); \
+                  struct _ { int sn; MNL_INLINE ~_() { tmp_stk.pop(sn); } } _; \
+                  for (_.sn = 0; _.sn < VAR_COUNT; ++_.sn) tmp_stk.push(init[_.sn].execute()); \
                   return body.exec_out(); \
                } \
             // end # define MNL_M1(VAR_COUNT)
@@ -1331,6 +1473,31 @@ namespace aux { namespace {
 
 namespace aux { namespace {
 
+   // Bulk construction, with the same result as by successive set for elems - O(n) for already sorted keys, O(n log n) otherwise
+   // (the merge sort here stays within bounds even for inconsistent orderings, unlike std::sort or std::stable_sort):
+   template<typename Val> dict<val, Val> make_dict(vector<pair<val, Val>> elems) {
+      auto size = elems.size(); decltype(size) sorted = 1;
+      while (sorted < size && order(elems[sorted - 1].first, elems[sorted].first) < 0) ++sorted;
+      if (MNL_UNLIKELY(sorted < size)) {
+         vector<pair<val, Val>> buf(size);
+         for (decltype(size) width = 1; width < size; width *= 2) {
+            for (decltype(size) lo = 0; lo < size; lo += 2 * width) {
+               auto mid = std::min(lo + width, size), hi = std::min(lo + 2 * width, size), lhs = lo, rhs = mid, dst = lo;
+               while (lhs < mid && rhs < hi) buf[dst++] = move(elems[order(elems[rhs].first, elems[lhs].first) < 0 ? rhs++ : lhs++]);
+               while (lhs < mid) buf[dst++] = move(elems[lhs++]);
+               while (rhs < hi)  buf[dst++] = move(elems[rhs++]);
+            }
+            elems.swap(buf);
+         }
+         sorted = 1; // equal keys are now adjacent and in their original order - the first key is kept with the last value
+         for (decltype(size) sn = 1; sn < size; ++sn) if (!order(elems[sorted - 1].first, elems[sn].first))
+            elems[sorted - 1].second = move(elems[sn].second); else if (sorted++ != sn) elems[sorted - 1] = move(elems[sn]);
+         size = sorted;
+      }
+      dict<val, Val> res; res.assign_sorted(elems.begin(), size);
+      return res;
+   }
+
    class comp_map { MNL_NONVALUE()
       MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) {
       opt1: // {map}
@@ -1348,9 +1515,9 @@ namespace aux { namespace {
             struct expr { MNL_RVALUE()
                vector<pair<code, code>> elems;
                MNL_INLINE val execute(bool) const {
-                  val res = dict<val, val>{};
-                  for (auto &&el: elems) cast<dict<val, val> &>(res).set({el.first.execute(), el.second.execute()});
-                  return res;
+                  vector<pair<val, val>> res; res.reserve(elems.size());
+                  for (auto &&el: elems) res.push_back({el.first.execute(), el.second.execute()});
+                  return make_dict(move(res));
                }
             };
             return expr{move(elems)};
@@ -1363,9 +1530,9 @@ namespace aux { namespace {
             struct expr { MNL_RVALUE()
                vector<code> elems;
                MNL_INLINE val execute(bool) const {
-                  val res = dict<val, val>{};
-                  for (auto &&el: elems) cast<dict<val, val> &>(res).set({el.execute()});
-                  return res;
+                  vector<pair<val, val>> res; res.reserve(elems.size());
+                  for (auto &&el: elems) res.push_back({el.execute(), {}});
+                  return make_dict(move(res));
                }
             };
             return expr{move(elems)};
@@ -1391,9 +1558,9 @@ namespace aux { namespace {
             struct expr { MNL_RVALUE()
                vector<code> elems;
                MNL_INLINE val execute(bool) const {
-                  val res = dict<val>{};
-                  for (auto &&el: elems) cast<dict<val> &>(res).set(el.execute());
-                  return res;
+                  vector<pair<val, dict_val_empty>> res; res.reserve(elems.size());
+                  for (auto &&el: elems) res.push_back({el.execute(), {}});
+                  return make_dict(move(res));
                }
             };
             return expr{move(elems)};
@@ -1406,9 +1573,9 @@ namespace aux { namespace {
             struct expr { MNL_RVALUE()
                vector<code> elems;
                MNL_INLINE val execute(bool) const {
-                  val res = dict<val>{};
-                  for (auto &&el: elems) cast<dict<val> &>(res).set(el.execute());
-                  return res;
+                  vector<pair<val, dict_val_empty>> res; res.reserve(elems.size());
+                  for (auto &&el: elems) res.push_back({el.execute(), {}});
+                  return make_dict(move(res));
                }
             };
             return expr{move(elems)};
@@ -1423,7 +1590,7 @@ namespace aux { namespace {
       opt1: // {sequence}
          {  if (form.size() == 1); else goto opt2;
          }
-         {  static const auto res = optimize(expr_lit<>{list<val>{}}); return res;
+         {  static const auto res = optimize(expr_lit<>{deque<val>{}}); return res;
          }
       opt2: // {sequence of V; V; ...}
          {  if (form.size() >= 3); else goto opt3;
@@ -1434,8 +1601,8 @@ namespace aux { namespace {
             struct expr { MNL_RVALUE()
                vector<code> elems;
                MNL_INLINE val execute(bool) const {
-                  val res = list<val>{};
-                  for (auto &&el: elems) cast<list<val> &>(res).push_back(el.execute());
+                  val res = deque<val>{};
+                  for (auto &&el: elems) cast<deque<val> &>(res).push_back(el.execute());
                   return res;
                }
             };
@@ -1502,7 +1669,7 @@ namespace aux { namespace {
          tmp_cnt = move(saved_tmp_cnt);
          for (auto &&el: tmp_ids) symtab.update(el, move(saved_tmp_ents.front())), saved_tmp_ents.pop_front();
 
-         if (!test<string>(res)) err_compile("type mismatch", _loc);
+         if (!res.box_string()) err_compile("type mismatch", _loc);
          err_compile(cast<const string &>(res).c_str(), _loc);
       }
    };
@@ -1510,13 +1677,14 @@ namespace aux { namespace {
    class comp_eval { MNL_NONVALUE()
       MNL_INLINE static code compile(code &&, const form &form, const loc &_loc) {
          if (form.size() != 2) err_compile("invalid form", _loc);
+         hoist_barrier(); // may assign any temporary in scope
          struct expr { MNL_LVALUE(true)
             code form; decltype(symtab) _symtab; decltype(tmp_cnt) _tmp_cnt; decltype(tmp_ids) _tmp_ids;
          public:
             MNL_INLINE val execute(bool fast_sig) const {
                return [&]()->code{
                   auto form = this->form.execute();
-                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = 0;
+                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = tmp_stk.top;
                   auto _finally_tmp_frm = finally([&]{ tmp_frm = move(saved_tmp_frm); });
                   auto saved_symtab = move(symtab); symtab = _symtab;
                   auto _finally_symtab = finally([&]{ symtab = move(saved_symtab); });
@@ -1530,7 +1698,7 @@ namespace aux { namespace {
             MNL_INLINE void exec_in(val &&value) const {
                [&]()->code{
                   auto form = this->form.execute();
-                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = 0;
+                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = tmp_stk.top;
                   auto _finally_tmp_frm = finally([&]{ tmp_frm = move(saved_tmp_frm); });
                   auto saved_symtab = move(symtab); symtab = _symtab;
                   auto _finally_symtab = finally([&]{ symtab = move(saved_symtab); });
@@ -1544,7 +1712,7 @@ namespace aux { namespace {
             MNL_INLINE val exec_out() const {
                return [&]()->code{
                   auto form = this->form.execute();
-                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = 0;
+                  auto saved_tmp_frm = move(tmp_frm); tmp_frm = tmp_stk.top;
                   auto _finally_tmp_frm = finally([&]{ tmp_frm = move(saved_tmp_frm); });
                   auto saved_symtab = move(symtab); symtab = _symtab;
                   auto _finally_symtab = finally([&]{ symtab = move(saved_symtab); });
@@ -1797,12 +1965,32 @@ namespace aux { namespace {
    };
 }} // namespace aux::<unnamed>
 
+// Typed Array Constructors ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux { namespace {
+   template<typename Dat> class proc_TypedArray {
+      MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+         if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+         if (MNL_LIKELY(argc == 1) && MNL_LIKELY(test<vector<val>>(argv[0]))) { // XArray[Array]
+            vector<Dat> res; res.reserve(cast<const vector<val> &>(argv[0]).size());
+            for (auto &&el: cast<const vector<val> &>(argv[0])) if (MNL_LIKELY(test<Dat>(el))) res.push_back(cast<Dat>(el)); else MNL_ERR(MNL_SYM("TypeMismatch"));
+            return res;
+         }
+         if (MNL_UNLIKELY(argc != 1) && MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation")); // XArray[Size] or XArray[Size; Elem]
+         if (MNL_UNLIKELY(!test<long long>(argv[0])) || MNL_UNLIKELY(argc == 2) && MNL_UNLIKELY(!test<Dat>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_UNLIKELY(cast<long long>(argv[0]) < 0)) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         return vector<Dat>(MNL_LIKELY(cast<long long>(argv[0]) <= lim<typename vector<Dat>::size_type>::max()) ?
+            cast<long long>(argv[0]) : throw std::bad_alloc{}, argc == 2 ? cast<Dat>(argv[1]) : Dat{});
+      }
+      friend box<proc_TypedArray>;
+   };
+}} // namespace aux::<unnamed>
+
 namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////////////////////////////////////////////////////////////////////////////////////
    struct proc_F64 { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       if (MNL_LIKELY(test<long long>(argv[0]))) return (double)cast<long long>(argv[0]);
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       switch (cast<const string &>(argv[0])[0]) {
       case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': case '.':
          break;
@@ -1821,7 +2009,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       if (MNL_LIKELY(test<long long>(argv[0]))) return (float)cast<long long>(argv[0]);
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       switch (cast<const string &>(argv[0])[0]) {
       case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': case '.':
          break;
@@ -1840,7 +2028,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       if (MNL_LIKELY(test<long long>(argv[0]))) return cast<long long>(argv[0]);
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       if (cast<const string &>(argv[0])[0] >= '0' && cast<const string &>(argv[0])[0] <= '9' ||
           cast<const string &>(argv[0])[0] == '+' || cast<const string &>(argv[0])[0] == '-'); else MNL_ERR(MNL_SYM("SyntaxError"));
       char *end; auto res = strtoll(cast<const string &>(argv[0]).c_str(), &end, {});
@@ -1852,7 +2040,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc == 0)) return (sym)nullptr;
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       if (cast<const string &>(argv[0])[0] != '`'); else MNL_ERR(MNL_SYM("SyntaxError"));
       return (sym)cast<const string &>(argv[0]);
    }};
@@ -1860,7 +2048,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       if (MNL_LIKELY(test<long long>(argv[0]))) return (unsigned)cast<long long>(argv[0]);
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       if (cast<const string &>(argv[0])[0] >= '0' && cast<const string &>(argv[0])[0] <= '9'); else MNL_ERR(MNL_SYM("SyntaxError"));
       char *end; auto res = strtoull(cast<const string &>(argv[0]).c_str(), &end, {});
       if (MNL_UNLIKELY(*end)) MNL_ERR(MNL_SYM("SyntaxError"));
@@ -1879,7 +2067,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
    struct proc_Parse { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       return parse(cast<const string &>(argv[0]));
    }};
    struct proc_IsList { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
@@ -1887,6 +2075,43 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
       return argv[0].is_list();
    }};
+   struct proc_IsS8 { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      return argv[0].is_string();
+   }};
+   struct proc_HashMap { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc % 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      hdict<val, val> res; res.reserve(argc / 2);
+      for (int sn = 0; sn < argc; sn += 2) res.set(move(argv[sn]), move(argv[sn + 1]));
+      return res;
+   }};
+   struct proc_HashSet { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      hdict<val> res; res.reserve(argc);
+      for (int sn = 0; sn < argc; ++sn) res.set(move(argv[sn]));
+      return res;
+   }};
+   struct proc_MakeMap { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      if (MNL_UNLIKELY(!test<vector<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      auto &&arr = cast<const vector<val> &>(argv[0]); // K; V; K; V; ...
+      if (MNL_UNLIKELY(arr.size() % 2)) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      vector<pair<val, val>> res; res.reserve(arr.size() / 2);
+      for (auto it = arr.begin(); it != arr.end(); it += 2) res.push_back({it[0], it[1]});
+      return make_dict(move(res));
+   }};
+   struct proc_MakeSet { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      if (MNL_UNLIKELY(!test<vector<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      auto &&arr = cast<const vector<val> &>(argv[0]);
+      vector<pair<val, dict_val_empty>> res; res.reserve(arr.size());
+      for (auto &&el: arr) res.push_back({el, {}});
+      return make_dict(move(res));
+   }};
    struct proc_OrderEx { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
@@ -1937,7 +2162,7 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       {"IsF64",       make_proc_test<double>()},
       {"IsF32",       make_proc_test<float>()},
       {"IsSym",       make_proc_test<sym>()},
-      {"IsS8",        make_proc_test<string>()},
+      {"IsS8",        make_lit(proc_IsS8{})},
       {"IsBool",      make_proc_test<bool>()},
       {"IsU32",       make_proc_test<unsigned>()},
       {"IsPtr",       make_proc_test<pointer>()},
@@ -1947,15 +2172,37 @@ namespace aux { extern "C" code mnl_aux_base() { // main ///////////////////////
       {"IsArray",     make_proc_test<vector<val>>()},
       {"IsMap",       make_proc_test<dict<val, val>>()},
       {"IsSet",       make_proc_test<dict<val>>()},
-      {"IsSequence",  make_proc_test<list<val>>()},
+      {"IsSequence",  make_proc_test<deque<val>>()},
+      {"IsHashMap",   make_proc_test<hdict<val, val>>()},
+      {"IsHashSet",   make_proc_test<hdict<val>>()},
       {"IsList",      make_lit(proc_IsList{})},
       {"IsCode",      make_proc_test<code>()},
       {"VarArg",      make_lit(proc_VarArg{})},
       {"VarApply",    make_lit(proc_VarApply{})},
       {"Bind",        make_lit(proc_Bind{})},
-      {"Min",         make_lit(proc_Min{})},
-      {"Max",         make_lit(proc_Max{})},
+      {"Min",         make_lit(proc_Extremum<false>{})},
+      {"Max",         make_lit(proc_Extremum<true>{})},
       {"OrderEx",     make_lit(proc_OrderEx{})},
+      {"HashMap",     make_lit(proc_HashMap{})},
+      {"HashSet",     make_lit(proc_HashSet{})},
+      {"MakeMap",     make_lit(proc_MakeMap{})},
+      {"MakeSet",     make_lit(proc_MakeSet{})},
+      {"F64Array",    make_lit(proc_TypedArray<double>{})},
+      {"F32Array",    make_lit(proc_TypedArray<float>{})},
+      {"I48Array",    make_lit(proc_TypedArray<long long>{})},
+      {"U32Array",    make_lit(proc_TypedArray<unsigned>{})},
+      {"IsF64Array",  make_proc_test<vector<double>>()},
+      {"IsF32Array",  make_proc_test<vector<float>>()},
+      {"IsI48Array",  make_proc_test<vector<long long>>()},
+      {"IsU32Array",  make_proc_test<vector<unsigned>>()},
+      {"Sum",         make_lit(proc_Sum{})},
+      {"Dot",         make_lit(proc_Dot{})},
+      {"Map2",        make_lit(proc_Map2{})},
+      {"Mapped",      make_lit(proc_LazyView<lazy_view::mapped>{})},
+      {"Filtered",    make_lit(proc_LazyView<lazy_view::filtered>{})},
+      {"Taken",       make_lit(proc_LazyView<lazy_view::taken>{})},
+      {"Zipped",      make_lit(proc_LazyView<lazy_view::zipped>{})},
+      {"Chained",     make_lit(proc_LazyView<lazy_view::chained>{})},
    };
 }}
 
@@ -17,12 +17,13 @@
 # include "mnl-lib-base.hh"
 # include "manool.hh"
 
-# include <iterator> // next, prev
+# include <iterator>  // next, prev, make_move_iterator
+# include <algorithm> // reverse
 
 namespace MNL_AUX_UUID { using namespace aux;
    namespace aux {
-      using std::next; using std::prev; // <iterator>
-      using std::list;
+      using std::next; using std::prev; using std::make_move_iterator; // <iterator>
+      using std::deque;
    }
 
 namespace aux { namespace {
@@ -75,15 +76,16 @@ namespace aux { namespace {
 }} // namespace aux::<unnamed>
 
    template<> val box<dict<val, val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
-      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "Keys", "Elems", "==", "<>", "Order", "Succ", "Pred", "Clone", "DeepClone")[op]) {
+      const auto &cdat = dat; // read-only access, which does not unshare anything (in case of pdict)
+      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "Keys", "Elems", "==", "<>", "Order", "Succ", "Pred", "Clone", "DeepClone", "Hash")[op]) {
       case  1: // Apply
          if (MNL_UNLIKELY(argc < 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+         {  auto it = cdat.find(argv[0]); if (MNL_UNLIKELY(it == cdat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
             return MNL_LIKELY(argc == 1) ? it->second : it->second(argc - 1, argv + 1);
          }
       case  2: // Exists
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         return dat.find(argv[0]) != dat.end();
+         return cdat.find(argv[0]) != cdat.end();
       case  3: // Repl
          if (MNL_UNLIKELY(argc < 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          if (MNL_LIKELY(rc() == 1)) {
@@ -205,14 +207,14 @@ namespace aux { namespace {
          }
       case 11: // Succ
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
-            if (MNL_UNLIKELY(++it == dat.end())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         {  auto it = cdat.find(argv[0]); if (MNL_UNLIKELY(it == cdat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+            if (MNL_UNLIKELY(++it == cdat.end())) MNL_ERR(MNL_SYM("ConstraintViolation"));
             return it->first;
          }
       case 12: // Pred
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
-            if (MNL_UNLIKELY(it == dat.begin())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         {  auto it = cdat.find(argv[0]); if (MNL_UNLIKELY(it == cdat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+            if (MNL_UNLIKELY(it == cdat.begin())) MNL_ERR(MNL_SYM("ConstraintViolation"));
             return (--it)->first;
          }
       case 13: // Clone
@@ -221,16 +223,20 @@ namespace aux { namespace {
       case 14: // DeepClone
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return [this]()->val{ val res = dat; for (auto &&el: cast<dict<val, val> &>(res)) el.second = MNL_SYM("DeepClone")(move(el.second)); return res; }();
+      case 15: // Hash
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = dat.size(); for (auto &&el: cdat) res = _hash_combine(_hash_combine(res, hash(el.first)), hash(el.second)); return res; }
       case 0:
          return self.default_invoke(op, argc, argv);
       }
    }
 
    template<> val box<dict<val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *) {
-      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "+", "|", "*", "-", "/", "Keys", "Elems", "==", "<>", "Order", "Succ", "Pred", "Clone")[op]) {
+      const auto &cdat = dat; // read-only access, which does not unshare anything (in case of pdict)
+      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "+", "|", "*", "-", "/", "Keys", "Elems", "==", "<>", "Order", "Succ", "Pred", "Clone", "Hash")[op]) {
       case  1: case  2: // Apply/Exists
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         return dat.find(argv[0]) != dat.end();
+         return cdat.find(argv[0]) != cdat.end();
       case  3: // Repl
          if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          if (MNL_UNLIKELY(!test<bool>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
@@ -262,11 +268,11 @@ namespace aux { namespace {
             return res;
          } else
          if (MNL_LIKELY(argv[0].rc() == 1) || dat.empty()) {
-            for (auto &&el: dat) cast<dict<val> &>(argv[0]).set(el.first);
+            for (auto &&el: cdat) cast<dict<val> &>(argv[0]).set(el.first);
             return move(argv[0]);
          } else {
             auto res = cast<const dict<val> &>(argv[0]);
-            for (auto &&el: dat) res.set(el.first);
+            for (auto &&el: cdat) res.set(el.first);
             return res;
          }
       case  7: // |
@@ -278,9 +284,9 @@ namespace aux { namespace {
          if (MNL_UNLIKELY(!test<dict<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
          {  decltype(dat) res;
             if (dat.size() >= cast<const dict<val> &>(argv[0]).size()) {
-               for (auto &&el: cast<const dict<val> &>(argv[0])) if (dat.find(el.first) != dat.end()) res.set(el.first);
+               for (auto &&el: cast<const dict<val> &>(argv[0])) if (cdat.find(el.first) != cdat.end()) res.set(el.first);
             } else {
-               for (auto &&el: dat) if (cast<const dict<val> &>(argv[0]).find(el.first) != cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
+               for (auto &&el: cdat) if (cast<const dict<val> &>(argv[0]).find(el.first) != cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
             }
             return res;
          }
@@ -298,7 +304,7 @@ namespace aux { namespace {
          } else
          if (dat.empty()) return move(self); else {
             decltype(dat) res;
-            for (auto &&el: dat) if (cast<const dict<val> &>(argv[0]).find(el.first) == cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
+            for (auto &&el: cdat) if (cast<const dict<val> &>(argv[0]).find(el.first) == cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
             return res;
          }
       case 10: // /
@@ -307,8 +313,8 @@ namespace aux { namespace {
          if (cast<const dict<val> &>(argv[0]).empty()) return move(self);
          if (dat.empty()) return move(argv[0]);
          {  decltype(dat) res;
-            for (auto &&el: dat) if (cast<const dict<val> &>(argv[0]).find(el.first) == cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
-            for (auto &&el: cast<const dict<val> &>(argv[0])) if (dat.find(el.first) == dat.end()) res.set(el.first);
+            for (auto &&el: cdat) if (cast<const dict<val> &>(argv[0]).find(el.first) == cast<const dict<val> &>(argv[0]).end()) res.set(el.first);
+            for (auto &&el: cast<const dict<val> &>(argv[0])) if (cdat.find(el.first) == cdat.end()) res.set(el.first);
             return res;
          }
       case 11: case 12: // Keys/Elems
@@ -368,26 +374,29 @@ namespace aux { namespace {
          }
       case 16: // Succ
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
-            if (MNL_UNLIKELY(++it == dat.end())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         {  auto it = cdat.find(argv[0]); if (MNL_UNLIKELY(it == cdat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+            if (MNL_UNLIKELY(++it == cdat.end())) MNL_ERR(MNL_SYM("ConstraintViolation"));
             return it->first;
          }
       case 17: // Pred
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
-            if (MNL_UNLIKELY(it == dat.begin())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         {  auto it = cdat.find(argv[0]); if (MNL_UNLIKELY(it == cdat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+            if (MNL_UNLIKELY(it == cdat.begin())) MNL_ERR(MNL_SYM("ConstraintViolation"));
             return (--it)->first;
          }
       case 18: // Clone
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return MNL_LIKELY(rc() == 1) ? move(self) : dat;
+      case 19: // Hash
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = dat.size(); for (auto &&el: cdat) res = _hash_combine(res, hash(el.first)); return res; }
       case 0:
          return self.default_invoke(op, argc, argv);
       }
    }
 
-   template<> val box<list<val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
-      switch (MNL_DISP("Apply", "Repl", "Size", "+", "|", "Elems", "Keys", "==", "<>", "Order", "Clone", "DeepClone")[op]) {
+   template<> val box<deque<val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
+      switch (MNL_DISP("Apply", "Repl", "Size", "+", "|", "Elems", "Keys", "==", "<>", "Order", "Clone", "DeepClone", "Hash")[op]) {
       case  1: // Apply
          if (MNL_LIKELY(argc == 1)) {
             if (MNL_LIKELY(test<long long>(argv[0]))) { // Sequence[Index]
@@ -401,16 +410,16 @@ namespace aux { namespace {
                if (MNL_LIKELY(rc() == 1)) return
                   dat.erase(std::prev(dat.end(), (long)dat.size() - (long)cast<range<>>(argv[0]).hi), dat.end()),
                   dat.erase(dat.begin(), std::next(dat.begin(), cast<range<>>(argv[0]).lo)), move(self);
-               return list<val>(
+               return deque<val>(
                   cseek(dat, cast<range<>>(argv[0]).lo),
                   cseek(dat, cast<range<>>(argv[0]).hi));
             }
             if (MNL_LIKELY(test<range<true>>(argv[0]))) { // Sequence[RevRange[Low; High]] - IMDOOs: all
                if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size()))
                   MNL_ERR(MNL_SYM("IndexOutOfRange"));
-               return list<val>(
-                  list<val>::const_reverse_iterator{cseek(dat, cast<range<true>>(argv[0]).hi)},
-                  list<val>::const_reverse_iterator{cseek(dat, cast<range<true>>(argv[0]).lo)});
+               return deque<val>(
+                  deque<val>::const_reverse_iterator{cseek(dat, cast<range<true>>(argv[0]).hi)},
+                  deque<val>::const_reverse_iterator{cseek(dat, cast<range<true>>(argv[0]).lo)});
             }
             MNL_ERR(MNL_SYM("TypeMismatch"));
          }
@@ -434,23 +443,23 @@ namespace aux { namespace {
                if (MNL_UNLIKELY(argv_out)) argv[1].swap(argv_out[1]);
                return res;
             }
-            if (MNL_UNLIKELY(!test<list<val>>(argv[1])))
+            if (MNL_UNLIKELY(!test<deque<val>>(argv[1])))
                MNL_ERR(MNL_SYM("TypeMismatch"));
             if (MNL_LIKELY(test<range<>>(argv[0]))) { // Sequence.Repl[Range[Low; High]; NewSequence]
                if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size()))
                   MNL_ERR(MNL_SYM("IndexOutOfRange"));
                if (MNL_LIKELY(rc() == 1)) return
                   MNL_LIKELY(argv[1].rc() == 1)
-                  ? (void)dat.splice(dat.erase(seek(dat, cast<range<>>(argv[0]).lo), seek(dat, cast<range<>>(argv[0]).hi)),
-                     cast<list<val> &>(argv[1]))
+                  ? (void)dat.insert(dat.erase(seek(dat, cast<range<>>(argv[0]).lo), seek(dat, cast<range<>>(argv[0]).hi)),
+                     make_move_iterator(cast<deque<val> &>(argv[1]).begin()), make_move_iterator(cast<deque<val> &>(argv[1]).end()))
                   : (void)dat.insert(dat.erase(seek(dat, cast<range<>>(argv[0]).lo), seek(dat, cast<range<>>(argv[0]).hi)),
-                     cast<const list<val> &>(argv[1]).begin(), cast<const list<val> &>(argv[1]).end()), move(self);
+                     cast<const deque<val> &>(argv[1]).begin(), cast<const deque<val> &>(argv[1]).end()), move(self);
                if (MNL_LIKELY(argv[1].rc() == 1)) return
-                  cast<list<val> &>(argv[1]).insert(cast<list<val> &>(argv[1]).begin(), dat.cbegin(), cseek(dat, cast<range<>>(argv[0]).lo)),
-                  cast<list<val> &>(argv[1]).insert(cast<list<val> &>(argv[1]).end(), cseek(dat, cast<range<>>(argv[0]).hi), dat.cend()), move(argv[1]);
-               if (cast<range<>>(argv[0]).lo == cast<range<>>(argv[0]).hi && cast<const list<val> &>(argv[1]).empty()) return move(self);
+                  cast<deque<val> &>(argv[1]).insert(cast<deque<val> &>(argv[1]).begin(), dat.cbegin(), cseek(dat, cast<range<>>(argv[0]).lo)),
+                  cast<deque<val> &>(argv[1]).insert(cast<deque<val> &>(argv[1]).end(), cseek(dat, cast<range<>>(argv[0]).hi), dat.cend()), move(argv[1]);
+               if (cast<range<>>(argv[0]).lo == cast<range<>>(argv[0]).hi && cast<const deque<val> &>(argv[1]).empty()) return move(self);
                if (!cast<range<>>(argv[0]).lo && cast<range<>>(argv[0]).hi == dat.size()) return move(argv[1]);
-               list<val> res(cast<const list<val> &>(argv[1]).begin(), cast<const list<val> &>(argv[1]).end());
+               deque<val> res(cast<const deque<val> &>(argv[1]).begin(), cast<const deque<val> &>(argv[1]).end());
                res.insert(res.begin(), dat.cbegin(), cseek(dat, cast<range<>>(argv[0]).lo));
                res.insert(res.end(), cseek(dat, cast<range<>>(argv[0]).hi), dat.cend());
                return res;
@@ -460,16 +469,16 @@ namespace aux { namespace {
                   MNL_ERR(MNL_SYM("IndexOutOfRange"));
                if (MNL_LIKELY(rc() == 1)) return
                   MNL_LIKELY(argv[1].rc() == 1)
-                  ? (void)dat.splice(dat.erase(seek(dat, cast<range<true>>(argv[0]).lo), seek(dat, cast<range<true>>(argv[0]).hi)),
-                     (cast<list<val> &>(argv[1]).reverse(), cast<list<val> &>(argv[1])))
+                  ? (void)dat.insert(dat.erase(seek(dat, cast<range<true>>(argv[0]).lo), seek(dat, cast<range<true>>(argv[0]).hi)),
+                     make_move_iterator(cast<deque<val> &>(argv[1]).rbegin()), make_move_iterator(cast<deque<val> &>(argv[1]).rend()))
                   : (void)dat.insert(dat.erase(seek(dat, cast<range<true>>(argv[0]).lo), seek(dat, cast<range<>>(argv[0]).hi)),
-                     cast<const list<val> &>(argv[1]).rbegin(), cast<const list<val> &>(argv[1]).rend()), move(self);
+                     cast<const deque<val> &>(argv[1]).rbegin(), cast<const deque<val> &>(argv[1]).rend()), move(self);
                if (MNL_LIKELY(argv[1].rc() == 1)) return
-                  cast<list<val> &>(argv[1]).reverse(),
-                  cast<list<val> &>(argv[1]).insert(cast<list<val> &>(argv[1]).begin(), dat.cbegin(), cseek(dat, cast<range<true>>(argv[0]).lo)),
-                  cast<list<val> &>(argv[1]).insert(cast<list<val> &>(argv[1]).end(), cseek(dat, cast<range<true>>(argv[0]).hi), dat.cend()), move(argv[1]);
-               if (cast<range<true>>(argv[0]).lo == cast<range<true>>(argv[0]).hi && cast<const list<val> &>(argv[1]).empty()) return move(self);
-               list<val> res(cast<const list<val> &>(argv[1]).rbegin(), cast<const list<val> &>(argv[1]).rend());
+                  std::reverse(cast<deque<val> &>(argv[1]).begin(), cast<deque<val> &>(argv[1]).end()),
+                  cast<deque<val> &>(argv[1]).insert(cast<deque<val> &>(argv[1]).begin(), dat.cbegin(), cseek(dat, cast<range<true>>(argv[0]).lo)),
+                  cast<deque<val> &>(argv[1]).insert(cast<deque<val> &>(argv[1]).end(), cseek(dat, cast<range<true>>(argv[0]).hi), dat.cend()), move(argv[1]);
+               if (cast<range<true>>(argv[0]).lo == cast<range<true>>(argv[0]).hi && cast<const deque<val> &>(argv[1]).empty()) return move(self);
+               deque<val> res(cast<const deque<val> &>(argv[1]).rbegin(), cast<const deque<val> &>(argv[1]).rend());
                res.insert(res.begin(), dat.cbegin(), cseek(dat, cast<range<true>>(argv[0]).lo));
                res.insert(res.end(), cseek(dat, cast<range<true>>(argv[0]).hi), dat.cend());
                return res;
@@ -486,30 +495,31 @@ namespace aux { namespace {
          MNL_ERR(MNL_SYM("InvalidInvocation"));
       case  3: // Size
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         return (long long)dat.size(); // ISSUE: in CentOS 6/7, even with SCL, list<T>::size() complexity is O(N), whereas in Ubuntu 18.04 LTS it's O(1)
+         return (long long)dat.size();
       case  4: // +
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         if (MNL_UNLIKELY(!test<list<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_UNLIKELY(!test<deque<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
          return
               MNL_LIKELY(rc() == 1)
-            ? (MNL_LIKELY(argv[0].rc() == 1) ? dat.splice(dat.end(), cast<list<val> &>(argv[0]))
-              : (void)dat.insert(dat.end(), cast<const list<val> &>(argv[0]).begin(), cast<const list<val> &>(argv[0]).end()),
+            ? (MNL_LIKELY(argv[0].rc() == 1) ? (void)dat.insert(dat.end(),
+                 make_move_iterator(cast<deque<val> &>(argv[0]).begin()), make_move_iterator(cast<deque<val> &>(argv[0]).end()))
+              : (void)dat.insert(dat.end(), cast<const deque<val> &>(argv[0]).begin(), cast<const deque<val> &>(argv[0]).end()),
               move(self))
             : MNL_LIKELY(argv[0].rc() == 1)
-            ? (cast<list<val> &>(argv[0]).insert(cast<list<val> &>(argv[0]).begin(), dat.cbegin(), dat.cend()), move(argv[0]))
-            : cast<const list<val> &>(argv[0]).empty() ? move(self) : dat.empty() ? move(argv[0])
+            ? (cast<deque<val> &>(argv[0]).insert(cast<deque<val> &>(argv[0]).begin(), dat.cbegin(), dat.cend()), move(argv[0]))
+            : cast<const deque<val> &>(argv[0]).empty() ? move(self) : dat.empty() ? move(argv[0])
             : [&]()->val{ val res = dat;
-               cast<list<val> &>(res).insert(cast<list<val> &>(res).end(), cast<const list<val> &>(argv[0]).begin(), cast<const list<val> &>(argv[0]).end());
+               cast<deque<val> &>(res).insert(cast<deque<val> &>(res).end(), cast<const deque<val> &>(argv[0]).begin(), cast<const deque<val> &>(argv[0]).end());
                return res;
             }();
       case  5: // |
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
          return MNL_LIKELY(rc() == 1) ? (dat.push_back(argv[0]), move(self))
-            : [&]()->val{ val res = dat; cast<list<val> &>(res).push_back(argv[0]); return res; }();
+            : [&]()->val{ val res = dat; cast<deque<val> &>(res).push_back(argv[0]); return res; }();
       case  6: // Elems
          if (MNL_LIKELY(argc == 0)) {
             struct traits {
-               typedef list<val>::const_iterator iterator;
+               typedef deque<val>::const_iterator iterator;
                MNL_INLINE static const val &fetch(iterator it) noexcept { return *it; }
             };
             return mnl_iter<traits>{move(self), (long)dat.size(), dat.cbegin()};
@@ -518,7 +528,7 @@ namespace aux { namespace {
          if (MNL_LIKELY(test<range<>>(argv[0]))) {
             if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
             struct traits {
-               typedef list<val>::const_iterator iterator;
+               typedef deque<val>::const_iterator iterator;
                MNL_INLINE static const val &fetch(iterator it) noexcept { return *it; }
             };
             return mnl_iter<traits>{move(self), (long)cast<range<>>(argv[0]).hi - (long)cast<range<>>(argv[0]).lo,
@@ -527,7 +537,7 @@ namespace aux { namespace {
          if (MNL_LIKELY(test<range<true>>(argv[0]))) {
             if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
             struct traits {
-               typedef list<val>::const_reverse_iterator iterator;
+               typedef deque<val>::const_reverse_iterator iterator;
                MNL_INLINE static const val &fetch(iterator it) noexcept { return *it; }
             };
             return mnl_iter<traits>{move(self), (long)cast<range<true>>(argv[0]).hi - (long)cast<range<true>>(argv[0]).lo,
@@ -548,29 +558,29 @@ namespace aux { namespace {
          MNL_ERR(MNL_SYM("TypeMismatch"));
       case  8: // ==
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         if (MNL_UNLIKELY(!test<list<val>>(argv[0]))) return false;
-         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const list<val> &>(argv[0])) return true;)
-         for (auto lhs = dat.cbegin(), rhs = cast<const list<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
-            if (MNL_UNLIKELY(lhs == dat.cend())) return rhs == cast<const list<val> &>(argv[0]).end();
-            if (MNL_UNLIKELY(rhs == cast<const list<val> &>(argv[0]).end())) return false;
+         if (MNL_UNLIKELY(!test<deque<val>>(argv[0]))) return false;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const deque<val> &>(argv[0])) return true;)
+         for (auto lhs = dat.cbegin(), rhs = cast<const deque<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
+            if (MNL_UNLIKELY(lhs == dat.cend())) return rhs == cast<const deque<val> &>(argv[0]).end();
+            if (MNL_UNLIKELY(rhs == cast<const deque<val> &>(argv[0]).end())) return false;
             if (MNL_UNLIKELY(!safe_cast<bool>(op(args<2>{*lhs, *rhs})))) return false;
          }
       case  9: // <>
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         if (MNL_UNLIKELY(!test<list<val>>(argv[0]))) return true;
-         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const list<val> &>(argv[0])) return false;)
-         for (auto lhs = dat.cbegin(), rhs = cast<const list<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
-            if (MNL_UNLIKELY(lhs == dat.cend())) return rhs == cast<const list<val> &>(argv[0]).end();
-            if (MNL_UNLIKELY(rhs == cast<const list<val> &>(argv[0]).end())) return true;
+         if (MNL_UNLIKELY(!test<deque<val>>(argv[0]))) return true;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const deque<val> &>(argv[0])) return false;)
+         for (auto lhs = dat.cbegin(), rhs = cast<const deque<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
+            if (MNL_UNLIKELY(lhs == dat.cend())) return rhs == cast<const deque<val> &>(argv[0]).end();
+            if (MNL_UNLIKELY(rhs == cast<const deque<val> &>(argv[0]).end())) return true;
             if (MNL_UNLIKELY( safe_cast<bool>(op(args<2>{*lhs, *rhs})))) return true;
          }
       case 10: // Order
          if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         if (MNL_UNLIKELY(!test<list<val>>(argv[0]))) return self.default_order(argv[0]);
-         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const list<val> &>(argv[0])) return 0;)
-         for (auto lhs = dat.cbegin(), rhs = cast<const list<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
-            if (MNL_UNLIKELY(lhs == dat.cend())) return -(rhs != cast<const list<val> &>(argv[0]).end());
-            if (MNL_UNLIKELY(rhs == cast<const list<val> &>(argv[0]).end())) return +1;
+         if (MNL_UNLIKELY(!test<deque<val>>(argv[0]))) return self.default_order(argv[0]);
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const deque<val> &>(argv[0])) return 0;)
+         for (auto lhs = dat.cbegin(), rhs = cast<const deque<val> &>(argv[0]).begin();; ++lhs, ++rhs) {
+            if (MNL_UNLIKELY(lhs == dat.cend())) return -(rhs != cast<const deque<val> &>(argv[0]).end());
+            if (MNL_UNLIKELY(rhs == cast<const deque<val> &>(argv[0]).end())) return +1;
             auto res = safe_cast<long long>(op(args<2>{*lhs, *rhs})); if (MNL_UNLIKELY(res)) return res;
          }
       case 11: // Clone
@@ -578,7 +588,285 @@ namespace aux { namespace {
          return MNL_LIKELY(rc() == 1) ? move(self) : dat;
       case 12: // DeepClone
          if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-         return [this]()->val{ val res = dat; for (auto &&el: cast<list<val> &>(res)) el = MNL_SYM("DeepClone")(move(el)); return res; }();
+         return [this]()->val{ val res = dat; for (auto &&el: cast<deque<val> &>(res)) el = MNL_SYM("DeepClone")(move(el)); return res; }();
+      case 13: // Hash
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = dat.size(); for (auto &&el: dat) res = _hash_combine(res, hash(el)); return res; }
+      case 0:
+         return self.default_invoke(op, argc, argv);
+      }
+   }
+
+   template<> val box<hdict<val, val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) {
+      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "Keys", "Elems", "==", "<>", "Clone", "DeepClone", "Hash")[op]) {
+      case  1: // Apply
+         if (MNL_UNLIKELY(argc < 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  auto it = dat.find(argv[0]); if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+            return MNL_LIKELY(argc == 1) ? it->second : it->second(argc - 1, argv + 1);
+         }
+      case  2: // Exists
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return dat.find(argv[0]) != dat.end();
+      case  3: // Repl
+         if (MNL_UNLIKELY(argc < 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(rc() == 1)) {
+            if (MNL_LIKELY(argc == 2)) {
+               if (MNL_UNLIKELY(argv_out)) { auto it = dat.find(argv[0]); if (MNL_LIKELY(it != dat.end())) argv_out[1].swap(it->second); }
+               dat.set(argv[0], move(argv[1]));
+            } else {
+               auto it = dat.find(argv[0]);
+               if (MNL_UNLIKELY(it == dat.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+               it->second = op(argc, (argv[0].swap(it->second), argv), argv_out);
+            }
+            return move(self);
+         } else {
+            auto res = dat;
+            if (MNL_LIKELY(argc == 2)) {
+               if (MNL_UNLIKELY(argv_out)) { auto it = res.find(argv[0]); if (MNL_LIKELY(it != res.end())) argv_out[1].swap(it->second); }
+               res.set(argv[0], move(argv[1]));
+            } else {
+               auto it = res.find(argv[0]);
+               if (MNL_UNLIKELY(it == res.end())) MNL_ERR(MNL_SYM("KeyLookupFailed"));
+               it->second = op(argc, (argv[0].swap(it->second), argv), argv_out);
+            }
+            return res;
+         }
+      case  4: // Delete
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(rc() == 1)) return dat.unset(argv[0]), move(self);
+         { auto res = dat; res.unset(argv[0]); return res; }
+      case  5: // Size
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return (long long)dat.size();
+      case  6: // Keys
+         if (MNL_LIKELY(argc == 0)) {
+            struct traits {
+               typedef hdict<val, val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)dat.size(), dat.cbegin()};
+         }
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<range<>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val, val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<>>(argv[0]).hi - (long)cast<range<>>(argv[0]).lo,
+               cseek(dat, cast<range<>>(argv[0]).lo)};
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val, val>::const_reverse_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<true>>(argv[0]).hi - (long)cast<range<true>>(argv[0]).lo,
+               traits::iterator{cseek(dat, cast<range<true>>(argv[0]).hi)}};
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case  7: // Elems
+         if (MNL_LIKELY(argc == 0)) {
+            struct traits {
+               typedef hdict<val, val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->second; }
+            };
+            return mnl_iter<traits>{move(self), (long)dat.size(), dat.cbegin()};
+         }
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<range<>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val, val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->second; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<>>(argv[0]).hi - (long)cast<range<>>(argv[0]).lo,
+               cseek(dat, cast<range<>>(argv[0]).lo)};
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val, val>::const_reverse_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->second; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<true>>(argv[0]).hi - (long)cast<range<true>>(argv[0]).lo,
+               traits::iterator{cseek(dat, cast<range<true>>(argv[0]).hi)}};
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case  8: // ==
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val, val>>(argv[0]))) return false;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const hdict<val, val> &>(argv[0])) return true;)
+         if (dat.size() != cast<const hdict<val, val> &>(argv[0]).size()) return false;
+         for (auto &&el: dat) {
+            auto it = cast<const hdict<val, val> &>(argv[0]).find(el.first);
+            if (MNL_UNLIKELY(it == cast<const hdict<val, val> &>(argv[0]).end()) || MNL_UNLIKELY(!safe_cast<bool>(op(args<2>{el.second, it->second}))))
+               return false;
+         }
+         return true;
+      case  9: // <>
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val, val>>(argv[0]))) return true;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const hdict<val, val> &>(argv[0])) return false;)
+         if (dat.size() != cast<const hdict<val, val> &>(argv[0]).size()) return true;
+         for (auto &&el: dat) {
+            auto it = cast<const hdict<val, val> &>(argv[0]).find(el.first);
+            if (MNL_UNLIKELY(it == cast<const hdict<val, val> &>(argv[0]).end()) || MNL_UNLIKELY( safe_cast<bool>(op(args<2>{el.second, it->second}))))
+               return true;
+         }
+         return false;
+      case 10: // Clone
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return MNL_LIKELY(rc() == 1) ? move(self) : dat;
+      case 11: // DeepClone
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return [this]()->val{ val res = dat; for (auto &&el: cast<hdict<val, val> &>(res)) el.second = MNL_SYM("DeepClone")(move(el.second)); return res; }();
+      case 12: // Hash (independent of the iteration order)
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  unsigned long long res = 0; for (auto &&el: dat) res += _hash_combine(hash(el.first), hash(el.second));
+            return _hash_combine(dat.size(), res & max_i48);
+         }
+      case 0:
+         return self.default_invoke(op, argc, argv);
+      }
+   }
+
+   template<> val box<hdict<val>>::invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      switch (MNL_DISP("Apply", "Exists", "Repl", "Delete", "Size", "+", "|", "*", "-", "/", "Keys", "Elems", "==", "<>", "Clone", "Hash")[op]) {
+      case  1: case  2: // Apply/Exists
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return dat.find(argv[0]) != dat.end();
+      case  3: // Repl
+         if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<bool>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_LIKELY(rc() == 1)) {
+            if (cast<bool>(argv[1])) dat.set(argv[0]); else dat.unset(argv[0]);
+            return move(self);
+         } else {
+            auto res = dat;
+            if (cast<bool>(argv[1])) res.set(argv[0]); else res.unset(argv[0]);
+            return res;
+         }
+      case  4: // Delete
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(rc() == 1)) return dat.unset(argv[0]), move(self);
+         { auto res = dat; res.unset(argv[0]); return res; }
+      case  5: // Size
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return (long long)dat.size();
+      case  6: // +
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (dat.size() >= cast<const hdict<val> &>(argv[0]).size())
+         if (MNL_LIKELY(rc() == 1) || cast<const hdict<val> &>(argv[0]).empty()) {
+            for (auto &&el: cast<const hdict<val> &>(argv[0])) dat.set(el.first);
+            return move(self);
+         } else {
+            auto res = dat;
+            for (auto &&el: cast<const hdict<val> &>(argv[0])) res.set(el.first);
+            return res;
+         } else
+         if (MNL_LIKELY(argv[0].rc() == 1) || dat.empty()) {
+            for (auto &&el: dat) cast<hdict<val> &>(argv[0]).set(el.first);
+            return move(argv[0]);
+         } else {
+            auto res = cast<const hdict<val> &>(argv[0]);
+            for (auto &&el: dat) res.set(el.first);
+            return res;
+         }
+      case  7: // |
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(rc() == 1)) return dat.set(move(argv[0])), move(self);
+         { auto res = dat; res.set(move(argv[0])); return res; }
+      case  8: // *
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         {  decltype(dat) res;
+            if (dat.size() >= cast<const hdict<val> &>(argv[0]).size()) {
+               for (auto &&el: cast<const hdict<val> &>(argv[0])) if (dat.find(el.first) != dat.end()) res.set(el.first);
+            } else {
+               for (auto &&el: dat) if (cast<const hdict<val> &>(argv[0]).find(el.first) != cast<const hdict<val> &>(argv[0]).end()) res.set(el.first);
+            }
+            return res;
+         }
+      case  9: // -
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (dat.size() >= cast<const hdict<val> &>(argv[0]).size())
+         if (MNL_LIKELY(rc() == 1) || cast<const hdict<val> &>(argv[0]).empty()) {
+            for (auto &&el: cast<const hdict<val> &>(argv[0])) dat.unset(el.first);
+            return move(self);
+         } else {
+            auto res = dat;
+            for (auto &&el: cast<const hdict<val> &>(argv[0])) res.unset(el.first);
+            return res;
+         } else
+         if (dat.empty()) return move(self); else {
+            decltype(dat) res;
+            for (auto &&el: dat) if (cast<const hdict<val> &>(argv[0]).find(el.first) == cast<const hdict<val> &>(argv[0]).end()) res.set(el.first);
+            return res;
+         }
+      case 10: // /
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (cast<const hdict<val> &>(argv[0]).empty()) return move(self);
+         if (dat.empty()) return move(argv[0]);
+         {  decltype(dat) res;
+            for (auto &&el: dat) if (cast<const hdict<val> &>(argv[0]).find(el.first) == cast<const hdict<val> &>(argv[0]).end()) res.set(el.first);
+            for (auto &&el: cast<const hdict<val> &>(argv[0])) if (dat.find(el.first) == dat.end()) res.set(el.first);
+            return res;
+         }
+      case 11: case 12: // Keys/Elems
+         if (MNL_LIKELY(argc == 0)) {
+            struct traits {
+               typedef hdict<val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)dat.size(), dat.cbegin()};
+         }
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<range<>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val>::const_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<>>(argv[0]).hi - (long)cast<range<>>(argv[0]).lo,
+               cseek(dat, cast<range<>>(argv[0]).lo)};
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            struct traits {
+               typedef hdict<val>::const_reverse_iterator iterator;
+               MNL_INLINE static const val &fetch(iterator it) noexcept { return it->first; }
+            };
+            return mnl_iter<traits>{move(self), (long)cast<range<true>>(argv[0]).hi - (long)cast<range<true>>(argv[0]).lo,
+               traits::iterator{cseek(dat, cast<range<true>>(argv[0]).hi)}};
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case 13: // ==
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) return false;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const hdict<val> &>(argv[0])) return true;)
+         if (dat.size() != cast<const hdict<val> &>(argv[0]).size()) return false;
+         for (auto &&el: dat) if (MNL_UNLIKELY(cast<const hdict<val> &>(argv[0]).find(el.first) == cast<const hdict<val> &>(argv[0]).end())) return false;
+         return true;
+      case 14: // <>
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<hdict<val>>(argv[0]))) return true;
+         MNL_IF_WITH_IDENT_OPT(if (&dat == &cast<const hdict<val> &>(argv[0])) return false;)
+         if (dat.size() != cast<const hdict<val> &>(argv[0]).size()) return true;
+         for (auto &&el: dat) if (MNL_UNLIKELY(cast<const hdict<val> &>(argv[0]).find(el.first) == cast<const hdict<val> &>(argv[0]).end())) return true;
+         return false;
+      case 15: // Clone
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return MNL_LIKELY(rc() == 1) ? move(self) : dat;
+      case 16: // Hash (independent of the iteration order)
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  unsigned long long res = 0; for (auto &&el: dat) res += hash(el.first);
+            return _hash_combine(dat.size(), res & max_i48);
+         }
       case 0:
          return self.default_invoke(op, argc, argv);
       }
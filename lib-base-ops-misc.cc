@@ -27,6 +27,7 @@ namespace MNL_AUX_UUID { using namespace aux;
       if (MNL_UNLIKELY(cleanup)) try {
          auto saved_heap_res = heap_reserve(0), saved_stk_res = stk_reserve(0);
          auto saved_sig_state = move(sig_state); sig_state.first = {};
+         auto saved_tail = move(tmp_stk.tail); tmp_stk.tail.pending = false; // a call left in tail position by the procedure being exited
          if (MNL_LIKELY(sig_trace.empty()))
             move(cleanup)(object{move(*this), move(methods)}); // in the rare case that this throws, the stack trace will be empty
          else {
@@ -34,6 +35,7 @@ namespace MNL_AUX_UUID { using namespace aux;
             move(cleanup)(object{move(*this), move(methods)}); // ditto
             sig_trace = move(saved_sig_trace);
          }
+         tmp_stk.tail = move(saved_tail);
          sig_state = move(saved_sig_state);
          heap_reserve(saved_heap_res), stk_reserve(saved_stk_res);
       } MNL_CATCH_UNEXPECTED
@@ -169,6 +171,7 @@ namespace MNL_AUX_UUID { using namespace aux;
       } else try {
          auto saved_heap_res = heap_reserve(0), saved_stk_res = stk_reserve(0);
          auto saved_sig_state = move(sig_state); sig_state.first = {};
+         auto saved_tail = move(tmp_stk.tail); tmp_stk.tail.pending = false; // a call left in tail position by the procedure being exited
          if (MNL_LIKELY(sig_trace.empty())) {
             if (!weak) weak = w_pointer{&value MNL_IF_WITH_MT(,mutex)}; // in the rare case that this throws, the stack trace will be empty
             move(cleanup)(weak); // ditto
@@ -178,6 +181,7 @@ namespace MNL_AUX_UUID { using namespace aux;
             move(cleanup)(weak); // ditto
             sig_trace = move(saved_sig_trace);
          }
+         tmp_stk.tail = move(saved_tail);
          sig_state = move(saved_sig_state);
          heap_reserve(saved_heap_res), stk_reserve(saved_stk_res);
          MNL_IF_WITH_MT(std::lock_guard<std::mutex>(cast<w_pointer &>(weak).mutex),) cast<w_pointer &>(weak).value = {};
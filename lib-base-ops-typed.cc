@@ -0,0 +1,479 @@
+// lib-base-ops-typed.cc -- operations on typed (unboxed) arrays and numeric kernels for Arrays
+
+/*    Copyright (C) 2018, 2019, 2020 Alexey Protasov (AKA Alex or rusini)
+
+   This file is part of MANOOL.
+
+   MANOOL is free software: you can redistribute it and/or modify it under the terms of the version 3 of the GNU General Public License
+   as published by the Free Software Foundation (and only version 3).
+
+   MANOOL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with MANOOL.  If not, see <https://www.gnu.org/licenses/>.  */
+
+
+# include "config.tcc"
+# include "mnl-lib-base.hh"
+# include "manool.hh"
+
+# include <algorithm> // min
+# include <cstring>   // memcpy
+
+namespace MNL_AUX_UUID { using namespace aux;
+   namespace aux {
+      using std::isnan; // <cmath>
+   }
+
+namespace aux { namespace {
+
+   // Element-wise Kernels /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+   // The loops below are shaped for auto-vectorization (SSE2 baseline on x86-64, plus AVX2 clones where MNL_SIMD_CLONES is available). Instead of signaling
+   // from within a loop, each kernel merely reports that some result in the block may be out of domain; the caller then redoes the block with ordinary scalar
+   // operations, which signal exactly as for individual elements.
+
+   template<typename Dat> using mask = typename std::conditional<sizeof(Dat) == sizeof(long long), long long, int>::type; // lane-sized flags vectorize best
+
+   template<typename Dat> MNL_INLINE static inline enable_core_binfloat<Dat, mask<Dat>> overflow(Dat res) noexcept { return isinf(res); }
+   template<typename Dat> MNL_INLINE static inline enable_same<Dat, long long, mask<Dat>> overflow(Dat res) noexcept { return (res < min_i48) | (res > max_i48); }
+   template<typename Dat> MNL_INLINE static inline enable_same<Dat, unsigned, mask<Dat>> overflow(Dat) noexcept { return false; }
+
+   struct op_add { template<typename Dat> MNL_INLINE static Dat exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept
+      { Dat res = lhs + rhs; bad |= overflow(res); return res; } };
+   struct op_sub { template<typename Dat> MNL_INLINE static Dat exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept
+      { Dat res = lhs - rhs; bad |= overflow(res); return res; } };
+   struct op_mul {
+      template<typename Dat> MNL_INLINE static typename std::enable_if<!std::is_same<Dat, long long>::value, Dat>::type exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept
+         { Dat res = lhs * rhs; bad |= overflow(res); return res; }
+      template<typename Dat> MNL_INLINE static enable_same<Dat, long long> exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept { // no wraparound for 32-bit factors
+         Dat res = (unsigned long long)lhs * (unsigned long long)rhs;
+         bad |= overflow(res) | (lhs < -lim<int>::max()) | (lhs > lim<int>::max()) | (rhs < -lim<int>::max()) | (rhs > lim<int>::max()); return res;
+      }
+   };
+   struct op_div {
+      template<typename Dat> MNL_INLINE static enable_core_binfloat<Dat> exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept
+         { Dat res = lhs / rhs; bad |= isinf(res) | isnan(res); return res; }
+      template<typename Dat> MNL_INLINE static typename std::enable_if<std::is_integral<Dat>::value, Dat>::type exec(Dat lhs, Dat rhs, mask<Dat> &bad) noexcept
+         { bad |= rhs == 0; return lhs / (rhs | rhs == 0); }
+   };
+   struct op_neg {
+      template<typename Dat> MNL_INLINE static Dat exec(Dat rhs) noexcept { return -rhs; }
+   };
+   struct op_abs {
+      template<typename Dat> MNL_INLINE static enable_core_binfloat<Dat> exec(Dat rhs) noexcept { return std::abs(rhs); }
+      template<typename Dat> MNL_INLINE static typename std::enable_if<std::is_integral<Dat>::value, Dat>::type exec(Dat rhs) noexcept { return rhs < 0 ? -rhs : rhs; }
+   };
+
+   template<typename Op, typename Dat> MNL_INLINE static inline bool _map2(Dat *__restrict res, const Dat *__restrict lhs, const Dat *__restrict rhs, int size) noexcept
+      { mask<Dat> bad{}; for (int sn = 0; sn < size; ++sn) res[sn] = Op::exec(lhs[sn], rhs[sn], bad); return bad; }
+   template<typename Op, typename Dat> MNL_INLINE static inline bool _map2(Dat *__restrict res, const Dat *__restrict lhs, Dat rhs, int size) noexcept
+      { mask<Dat> bad{}; for (int sn = 0; sn < size; ++sn) res[sn] = Op::exec(lhs[sn], rhs, bad); return bad; }
+   template<typename Op, typename Dat> MNL_INLINE static inline void _map1(Dat *res, const Dat *rhs, size_t size) noexcept // in-place allowed
+      { for (size_t sn = 0; sn < size; ++sn) res[sn] = Op::exec(rhs[sn]); }
+
+# define MNL_M(OP, DAT) \
+   MNL_SIMD_CLONES MNL_NOINLINE bool simd_##OP(DAT *__restrict res, const DAT *__restrict lhs, const DAT *__restrict rhs, int size) noexcept \
+      { return _map2<op_##OP>(res, lhs, rhs, size); } \
+   MNL_SIMD_CLONES MNL_NOINLINE bool simd_##OP(DAT *__restrict res, const DAT *__restrict lhs, DAT rhs, int size) noexcept \
+      { return _map2<op_##OP>(res, lhs, rhs, size); } \
+// end # define MNL_M(OP, DAT)
+# define MNL_M1(OP, DAT) \
+   MNL_SIMD_CLONES MNL_NOINLINE void simd_##OP(DAT *res, const DAT *rhs, size_t size) noexcept { _map1<op_##OP>(res, rhs, size); } \
+// end # define MNL_M1(OP, DAT)
+# define MNL_M2(DAT) MNL_M(add, DAT) MNL_M(sub, DAT) MNL_M(mul, DAT) MNL_M(div, DAT) MNL_M1(neg, DAT) MNL_M1(abs, DAT)
+   MNL_M2(double) MNL_M2(float) MNL_M2(long long) MNL_M2(unsigned)
+# undef MNL_M2
+# undef MNL_M1
+# undef MNL_M
+
+   // Reduction Kernels ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+   // Sums are accumulated lane-wise (one AVX2 register worth of partial sums), so for F64 and F32 the result may differ in the last bits from a left fold
+   // (I48 sums are exact, and their running totals are checked for overflow separately, see sum below).
+   // Min and Max compare integer keys obtained from the FP bit patterns, which yields the same total order (-0.0 < +0.0) as for the Min and Max procedures.
+
+   template<typename Dat> MNL_INLINE static inline Dat _sum(const Dat *__restrict rhs, int size) noexcept {
+      enum { lanes = 32 / sizeof(Dat) }; Dat acc[lanes]{}; int sn = 0;
+      for (; sn <= size - lanes; sn += lanes) for (int ln = 0; ln < lanes; ++ln) acc[ln] += rhs[sn + ln];
+      for (; sn < size; ++sn) acc[0] += rhs[sn];
+      Dat res = acc[0]; for (int ln = 1; ln < lanes; ++ln) res += acc[ln]; return res;
+   }
+   template<typename Dat> MNL_INLINE static inline bool _dot(Dat &res, const Dat *__restrict lhs, const Dat *__restrict rhs, int size) noexcept {
+      enum { lanes = 32 / sizeof(Dat) }; Dat acc[lanes]{}; mask<Dat> bad{}; int sn = 0;
+      for (; sn <= size - lanes; sn += lanes) for (int ln = 0; ln < lanes; ++ln) acc[ln] += op_mul::exec(lhs[sn + ln], rhs[sn + ln], bad);
+      for (; sn < size; ++sn) acc[0] += op_mul::exec(lhs[sn], rhs[sn], bad);
+      res = acc[0]; for (int ln = 1; ln < lanes; ++ln) res += acc[ln]; return bad;
+   }
+
+   template<typename Dat> MNL_INLINE static inline enable_core_binfloat<Dat, mask<Dat>> _key(Dat rhs) noexcept
+      { mask<Dat> res; memcpy(&res, &rhs, sizeof res); return res ^ (res >> (sizeof res * 8 - 1) & lim<mask<Dat>>::max()); }
+   template<typename Dat> MNL_INLINE static inline typename std::enable_if<std::is_integral<Dat>::value, Dat>::type _key(Dat rhs) noexcept
+      { return rhs; }
+   template<typename Dat> MNL_INLINE static inline enable_core_binfloat<Dat> _unkey(mask<Dat> key) noexcept
+      { key ^= key >> (sizeof key * 8 - 1) & lim<mask<Dat>>::max(); Dat res; memcpy(&res, &key, sizeof res); return res; }
+   template<typename Dat> MNL_INLINE static inline typename std::enable_if<std::is_integral<Dat>::value, Dat>::type _unkey(Dat key) noexcept
+      { return key; }
+   template<bool Max, typename Dat> MNL_INLINE static inline Dat _extremum(Dat init, const Dat *rhs, int size) noexcept {
+      auto res = _key(init);
+      for (int sn = 0; sn < size; ++sn) { auto key = _key(rhs[sn]); res = Max ? (key > res ? key : res) : (key < res ? key : res); }
+      return _unkey<Dat>(res);
+   }
+
+# define MNL_R(DAT) \
+   MNL_SIMD_CLONES MNL_NOINLINE DAT simd_sum(const DAT *rhs, int size) noexcept { return _sum(rhs, size); } \
+   MNL_SIMD_CLONES MNL_NOINLINE bool simd_dot(DAT &res, const DAT *lhs, const DAT *rhs, int size) noexcept { return _dot(res, lhs, rhs, size); } \
+   MNL_SIMD_CLONES MNL_NOINLINE DAT simd_min(DAT init, const DAT *rhs, int size) noexcept { return _extremum<false>(init, rhs, size); } \
+   MNL_SIMD_CLONES MNL_NOINLINE DAT simd_max(DAT init, const DAT *rhs, int size) noexcept { return _extremum<true>(init, rhs, size); } \
+// end # define MNL_R(DAT)
+   MNL_R(double) MNL_R(float) MNL_R(long long) MNL_R(unsigned)
+# undef MNL_R
+   template<bool Max, typename Dat> MNL_INLINE static inline Dat simd_extremum(Dat init, const Dat *rhs, int size) noexcept
+      { return Max ? simd_max(init, rhs, size) : simd_min(init, rhs, size); }
+
+   enum { block = 256 }; // elements per kernel invocation (results and unboxed operands go through buffers of this size)
+
+   template<typename Dat> MNL_INLINE static inline const Dat *_at(const Dat *rhs, size_t pos) noexcept { return rhs + pos; }
+   template<typename Dat> MNL_INLINE static inline Dat _at(Dat rhs, size_t) noexcept { return rhs; }
+   template<typename Dat> MNL_INLINE static inline Dat _el(const Dat *rhs, int sn) noexcept { return rhs[sn]; }
+   template<typename Dat> MNL_INLINE static inline Dat _el(Dat rhs, int) noexcept { return rhs; }
+
+   template<typename Dat, typename Rhs> void map2(const sym &op, bool kernel(Dat *, const Dat *, Rhs, int), Dat *res, const Dat *lhs, Rhs rhs, size_t size) {
+      // results go through a small buffer so that res may coincide with lhs or rhs
+      for (size_t pos = 0; pos < size; pos += block) {
+         int count = std::min(size - pos, (size_t)block); Dat tmp[block];
+         if (MNL_UNLIKELY(kernel(tmp, lhs + pos, _at(rhs, pos), count)))
+            for (int sn = 0; sn < count; ++sn) tmp[sn] = cast<Dat>(op(args<2>{lhs[pos + sn], _el(_at(rhs, pos), sn)}));
+         memcpy(res + pos, tmp, count * sizeof(Dat));
+      }
+   }
+   template<typename Dat> val map2(val &&self, vector<Dat> &dat, const sym &op, val &rhs,
+      bool kernel(Dat *, const Dat *, const Dat *, int), bool kernel_s(Dat *, const Dat *, Dat, int)) {
+      if (MNL_LIKELY(test<vector<Dat>>(rhs))) { // Array op Array (same type and size)
+         if (MNL_UNLIKELY(cast<const vector<Dat> &>(rhs).size() != dat.size())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+         if (MNL_LIKELY(self.rc() == 1))
+            return map2(op, kernel, dat.data(), dat.data(), cast<const vector<Dat> &>(rhs).data(), dat.size()), move(self);
+         if (MNL_LIKELY(rhs.rc() == 1)) return map2(op, kernel,
+            cast<vector<Dat> &>(rhs).data(), dat.data(), cast<const vector<Dat> &>(rhs).data(), dat.size()), move(rhs);
+         vector<Dat> res(dat.size()); map2(op, kernel, res.data(), dat.data(), cast<const vector<Dat> &>(rhs).data(), dat.size()); return res;
+      }
+      if (MNL_LIKELY(test<Dat>(rhs))) { // Array op Scalar
+         if (MNL_LIKELY(self.rc() == 1)) return map2(op, kernel_s, dat.data(), dat.data(), cast<Dat>(rhs), dat.size()), move(self);
+         vector<Dat> res(dat.size()); map2(op, kernel_s, res.data(), dat.data(), cast<Dat>(rhs), dat.size()); return res;
+      }
+      MNL_ERR(MNL_SYM("TypeMismatch"));
+   }
+   template<typename Dat> val map1(val &&self, vector<Dat> &dat, void kernel(Dat *, const Dat *, size_t)) {
+      if (MNL_LIKELY(self.rc() == 1)) return kernel(dat.data(), dat.data(), dat.size()), move(self);
+      vector<Dat> res(dat.size()); kernel(res.data(), dat.data(), dat.size()); return res;
+   }
+
+   template<typename Dat> MNL_INLINE static inline enable_core_binfloat<Dat, long long> elem_order(Dat lhs, Dat rhs) noexcept
+      { return _order(lhs, rhs); }
+   template<typename Dat> MNL_INLINE static inline typename std::enable_if<std::is_integral<Dat>::value, long long>::type elem_order(Dat lhs, Dat rhs) noexcept
+      { return (lhs > rhs) - (lhs < rhs); }
+
+   // Typed Arrays /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+   template<typename Dat> val typed_invoke(vector<Dat> &dat, val &&self, const sym &op, int argc, val argv[], val *argv_out) {
+      static const auto compact = [](vector<Dat> &dat)
+         { if (MNL_UNLIKELY(dat.capacity() > dat.size() * 2)) dat.shrink_to_fit(); };
+      switch (MNL_DISP("Apply", "Repl", "Size", "|", "+", "-", "*", "/", "Neg", "Abs", "Elems", "Keys", "^", "==", "<>", "Order", "Clone", "DeepClone",
+         "Hash")[op]) {
+      case  1: // Apply
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<long long>(argv[0]))) { // Array[Index]
+            if (MNL_UNLIKELY(cast<long long>(argv[0]) < 0) || MNL_UNLIKELY(cast<long long>(argv[0]) >= dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            return dat[cast<long long>(argv[0])];
+         }
+         if (MNL_LIKELY(test<range<>>(argv[0]))) { // Array[Range[Low; High]]
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            if (MNL_LIKELY(self.rc() == 1)) return
+               dat.resize(cast<range<>>(argv[0]).hi), dat.erase(dat.begin(), dat.begin() + cast<range<>>(argv[0]).lo), compact(dat), move(self);
+            return vector<Dat>(dat.cbegin() + cast<range<>>(argv[0]).lo, dat.cbegin() + cast<range<>>(argv[0]).hi);
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) { // Array[RevRange[Low; High]]
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            return vector<Dat>(dat.crend() - cast<range<true>>(argv[0]).hi, dat.crend() - cast<range<true>>(argv[0]).lo);
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case  2: // Repl
+         if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<long long>(argv[0]))) { // Array.Repl[Index; NewElem]
+            if (MNL_UNLIKELY(!test<Dat>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+            if (MNL_UNLIKELY(cast<long long>(argv[0]) < 0) || MNL_UNLIKELY(cast<long long>(argv[0]) >= dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            if (MNL_UNLIKELY(argv_out)) argv_out[1] = dat[cast<long long>(argv[0])];
+            if (MNL_LIKELY(self.rc() == 1)) return dat[cast<long long>(argv[0])] = cast<Dat>(argv[1]), move(self);
+            {  auto res = dat; res[cast<long long>(argv[0])] = cast<Dat>(argv[1]); return res; }
+         }
+         if (MNL_UNLIKELY(!test<vector<Dat>>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_LIKELY(test<range<>>(argv[0]))) { // Array.Repl[Range[Low; High]; NewArray]
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            vector<Dat> res; res.reserve((size_t)cast<range<>>(argv[0]).lo +
+               cast<const vector<Dat> &>(argv[1]).size() + (dat.size() - (size_t)cast<range<>>(argv[0]).hi));
+            res.assign(dat.cbegin(), dat.cbegin() + cast<range<>>(argv[0]).lo);
+            res.insert(res.cend(), cast<const vector<Dat> &>(argv[1]).begin(), cast<const vector<Dat> &>(argv[1]).end());
+            res.insert(res.cend(), dat.cbegin() + cast<range<>>(argv[0]).hi, dat.cend());
+            return res;
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) { // Array.Repl[RevRange[Low; High]; NewArray]
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size()))
+               MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            vector<Dat> res; res.reserve((size_t)cast<range<true>>(argv[0]).lo +
+               cast<const vector<Dat> &>(argv[1]).size() + (dat.size() - (size_t)cast<range<true>>(argv[0]).hi));
+            res.assign(dat.cbegin(), dat.cbegin() + cast<range<true>>(argv[0]).lo);
+            res.insert(res.cend(), cast<const vector<Dat> &>(argv[1]).rbegin(), cast<const vector<Dat> &>(argv[1]).rend());
+            res.insert(res.cend(), dat.cbegin() + cast<range<true>>(argv[0]).hi, dat.cend());
+            return res;
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case  3: // Size
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return (long long)dat.size();
+      case  4: // |
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<Dat>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         if (MNL_LIKELY(self.rc() == 1)) return dat.push_back(cast<Dat>(argv[0])), move(self);
+         {  vector<Dat> res; res.reserve(dat.size() + 1); res = dat; res.push_back(cast<Dat>(argv[0])); return res; }
+      case  5: // +
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map2(move(self), dat, op, argv[0], simd_add, simd_add);
+      case  6: // -
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map2(move(self), dat, op, argv[0], simd_sub, simd_sub);
+      case  7: // *
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map2(move(self), dat, op, argv[0], simd_mul, simd_mul);
+      case  8: // /
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map2(move(self), dat, op, argv[0], simd_div, simd_div);
+      case  9: // Neg
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map1(move(self), dat, simd_neg);
+      case 10: // Abs
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return map1(move(self), dat, simd_abs);
+      case 11: // Elems
+         if (MNL_LIKELY(argc == 0)) return move(self);
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<range<>>(argv[0])) && MNL_UNLIKELY(!test<range<true>>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+         return move(self)(argc, argv); // same as slicing
+      case 12: // Keys
+         if (MNL_LIKELY(argc == 0)) return range<>{0, (long long)dat.size()};
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_LIKELY(test<range<>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            return move(argv[0]);
+         }
+         if (MNL_LIKELY(test<range<true>>(argv[0]))) {
+            if (MNL_UNLIKELY(cast<range<true>>(argv[0]).lo < 0) || MNL_UNLIKELY(cast<range<true>>(argv[0]).hi > dat.size())) MNL_ERR(MNL_SYM("IndexOutOfRange"));
+            return move(argv[0]);
+         }
+         MNL_ERR(MNL_SYM("TypeMismatch"));
+      case 13: // ^
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return move(self);
+      case 14: // ==
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return MNL_LIKELY(test<vector<Dat>>(argv[0])) && dat == cast<const vector<Dat> &>(argv[0]);
+      case 15: // <>
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return !MNL_LIKELY(test<vector<Dat>>(argv[0])) || dat != cast<const vector<Dat> &>(argv[0]);
+      case 16: // Order
+         if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         if (MNL_UNLIKELY(!test<vector<Dat>>(argv[0]))) return self.default_order(argv[0]);
+         for (auto lhs = dat.cbegin(), rhs = cast<const vector<Dat> &>(argv[0]).begin();; ++lhs, ++rhs) {
+            if (MNL_UNLIKELY(lhs == dat.cend())) return -(rhs != cast<const vector<Dat> &>(argv[0]).end());
+            if (MNL_UNLIKELY(rhs == cast<const vector<Dat> &>(argv[0]).end())) return +1;
+            auto res = elem_order(*lhs, *rhs); if (MNL_UNLIKELY(res)) return res;
+         }
+      case 17: case 18: // Clone, DeepClone
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         return MNL_LIKELY(self.rc() == 1) ? move(self) : dat;
+      case 19: // Hash
+         if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+         {  long long res = dat.size(); for (auto &&el: dat) res = _hash_combine(res, _hash(el)); return res; }
+      case  0:
+         return self.default_invoke(op, argc, argv);
+      }
+   }
+
+   // Arrays ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+   // Whenever all elements of an Array are I48 (or all are F64) values, they are unboxed block-wise and fed to the above kernels; otherwise (or on potential
+   // overflow) we fall back to folding or mapping with ordinary operations, which also takes care of signaling. For I48 sums, overflow is potential as soon
+   // as any running total (not only a block total) may leave the I48 range, so that Sum signals exactly when the equivalent left fold does.
+
+   template<typename Dat> MNL_INLINE static inline bool uniform(const vector<val> &dat) noexcept
+      { for (auto &&el: dat) if (MNL_UNLIKELY(!test<Dat>(el))) return false; return true; }
+   template<typename Dat> MNL_INLINE static inline const Dat *_load(Dat (&)[block], const Dat *src, size_t pos, int) noexcept
+      { return src + pos; }
+   template<typename Dat> MNL_INLINE static inline const Dat *_load(Dat (&tmp)[block], const val *src, size_t pos, int count) noexcept
+      { for (int sn = 0; sn < count; ++sn) tmp[sn] = cast<Dat>(src[pos + sn]); return tmp; }
+
+   template<typename Src> val fold_sum(const Src *src, size_t size) { // size > 0
+      val res = src[0];
+      for (size_t sn = 1; sn < size; ++sn) res = MNL_SYM("+")(args<2>{move(res), src[sn]});
+      return res;
+   }
+   template<typename Src> val fold_dot(const Src *lhs, const Src *rhs, size_t size) { // size > 0
+      val res = MNL_SYM("*")(args<2>{lhs[0], rhs[0]});
+      for (size_t sn = 1; sn < size; ++sn) res = MNL_SYM("+")(args<2>{move(res), MNL_SYM("*")(args<2>{lhs[sn], rhs[sn]})});
+      return res;
+   }
+
+   template<typename Dat> MNL_INLINE static inline bool _prefix_ok(Dat, const Dat *, int) noexcept
+      { return true; } // F64, F32: infinities and NaNs persist, and U32 wraps around, so checking the totals suffices
+   MNL_INLINE static inline bool _prefix_ok(long long res, const long long *rhs, int count) noexcept { // I48: no running total res + rhs[0] + ... overflows
+      long long mag = res < 0 ? -res : res; for (int sn = 0; sn < count; ++sn) mag += rhs[sn] < 0 ? -rhs[sn] : rhs[sn]; // a cheap upper bound
+      if (MNL_LIKELY(mag <= max_i48)) return true;
+      for (int sn = 0; sn < count; ++sn) if (MNL_UNLIKELY(overflow(res += rhs[sn]))) return false; return true;
+   }
+
+   template<typename Dat, typename Src> val sum(const Src *src, size_t size) {
+      Dat tmp[block], res{};
+      for (size_t pos = 0; pos < size; pos += block) {
+         int count = std::min(size - pos, (size_t)block); auto rhs = _load(tmp, src, pos, count);
+         if (MNL_UNLIKELY(!_prefix_ok(res, rhs, count))) return fold_sum(src, size);
+         res += simd_sum(rhs, count);
+         if (MNL_UNLIKELY(overflow(res) | (res != res))) return fold_sum(src, size);
+      }
+      return res;
+   }
+   template<typename Dat, typename Src> val dot(const Src *lhs, const Src *rhs, size_t size) {
+      Dat lhs_tmp[block], rhs_tmp[block], res{}, part;
+      for (size_t pos = 0; pos < size; pos += block) {
+         int count = std::min(size - pos, (size_t)block);
+         if (MNL_UNLIKELY(simd_dot(part, _load(lhs_tmp, lhs, pos, count), _load(rhs_tmp, rhs, pos, count), count))) return fold_dot(lhs, rhs, size);
+         res += part;
+         if (MNL_UNLIKELY(overflow(res) | (res != res))) return fold_dot(lhs, rhs, size);
+      }
+      return res;
+   }
+   template<bool Max, typename Dat, typename Src> val extremum(const Src *src, size_t size) { // size > 0
+      Dat tmp[block], res = _load(tmp, src, 0, 1)[0];
+      for (size_t pos = 0; pos < size; pos += block) {
+         int count = std::min(size - pos, (size_t)block);
+         res = simd_extremum<Max>(res, _load(tmp, src, pos, count), count);
+      }
+      return res;
+   }
+   template<typename Dat> void map2(const sym &op, bool kernel(Dat *, const Dat *, const Dat *, int), vector<val> &res, const vector<val> &lhs, const vector<val> &rhs) {
+      // res may coincide with lhs
+      for (size_t pos = 0; pos < res.size(); pos += block) {
+         int count = std::min(res.size() - pos, (size_t)block); Dat lhs_tmp[block], rhs_tmp[block], tmp[block];
+         if (MNL_UNLIKELY(kernel(tmp, _load(lhs_tmp, lhs.data(), pos, count), _load(rhs_tmp, rhs.data(), pos, count), count)))
+            for (int sn = 0; sn < count; ++sn) tmp[sn] = cast<Dat>(op(args<2>{lhs[pos + sn], rhs[pos + sn]}));
+         for (int sn = 0; sn < count; ++sn) res[pos + sn] = tmp[sn];
+      }
+   }
+   bool map2(const sym &op, bool kernel_i48(long long *, const long long *, const long long *, int), bool kernel_f64(double *, const double *, const double *, int),
+      vector<val> &res, const vector<val> &lhs, const vector<val> &rhs) {
+      if (uniform<long long>(lhs) && uniform<long long>(rhs)) return map2(op, kernel_i48, res, lhs, rhs), true;
+      if (uniform<double>(lhs) && uniform<double>(rhs)) return map2(op, kernel_f64, res, lhs, rhs), true;
+      return false;
+   }
+
+   val sum(const vector<val> &dat) {
+      if (uniform<long long>(dat)) return sum<long long>(dat.data(), dat.size()); // Sum[{array}] == 0
+      if (uniform<double>(dat)) return sum<double>(dat.data(), dat.size());
+      return fold_sum(dat.data(), dat.size());
+   }
+   template<typename Dat> val sum(const vector<Dat> &dat)
+      { return sum<Dat>(dat.data(), dat.size()); }
+   val dot(const vector<val> &lhs, const val &rhs) {
+      if (MNL_UNLIKELY(!test<vector<val>>(rhs))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      auto &&dat = cast<const vector<val> &>(rhs);
+      if (MNL_UNLIKELY(dat.size() != lhs.size())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      if (uniform<long long>(lhs) && uniform<long long>(dat)) return dot<long long>(lhs.data(), dat.data(), lhs.size());
+      if (uniform<double>(lhs) && uniform<double>(dat)) return dot<double>(lhs.data(), dat.data(), lhs.size());
+      return fold_dot(lhs.data(), dat.data(), lhs.size());
+   }
+   template<typename Dat> val dot(const vector<Dat> &lhs, const val &rhs) {
+      if (MNL_UNLIKELY(!test<vector<Dat>>(rhs))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      auto &&dat = cast<const vector<Dat> &>(rhs);
+      if (MNL_UNLIKELY(dat.size() != lhs.size())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      return dot<Dat>(lhs.data(), dat.data(), lhs.size());
+   }
+   template<bool Max> val extremum(const vector<val> &dat) {
+      if (MNL_UNLIKELY(dat.empty())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      if (uniform<long long>(dat)) return extremum<Max, long long>(dat.data(), dat.size());
+      if (uniform<double>(dat)) return extremum<Max, double>(dat.data(), dat.size());
+      static const val proc = Max ? val(proc_Max{}) : val(proc_Min{});
+      val res = dat[0]; for (size_t sn = 1; sn < dat.size(); ++sn) res = proc(args<2>{move(res), dat[sn]}); return res;
+   }
+   template<bool Max, typename Dat> val extremum(const vector<Dat> &dat) {
+      if (MNL_UNLIKELY(dat.empty())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      return extremum<Max, Dat>(dat.data(), dat.size());
+   }
+
+}} // namespace aux::<unnamed>
+
+   template<> val box<vector<double>>   ::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) // F64Array
+      { return aux::typed_invoke(dat, move(self), op, argc, argv, argv_out); }
+   template<> val box<vector<float>>    ::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) // F32Array
+      { return aux::typed_invoke(dat, move(self), op, argc, argv, argv_out); }
+   template<> val box<vector<long long>>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) // I48Array
+      { return aux::typed_invoke(dat, move(self), op, argc, argv, argv_out); }
+   template<> val box<vector<unsigned>> ::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) // U32Array
+      { return aux::typed_invoke(dat, move(self), op, argc, argv, argv_out); }
+
+
+   val proc_Sum::invoke(val &&self, const sym &op, int argc, val argv[], val *) { // Sum[Array]
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      if (MNL_LIKELY(test<vector<val>>(argv[0])))  return aux::sum(cast<const vector<val> &>(argv[0]));
+      if (test<vector<double>>(argv[0]))    return aux::sum(cast<const vector<double> &>(argv[0]));
+      if (test<vector<float>>(argv[0]))     return aux::sum(cast<const vector<float> &>(argv[0]));
+      if (test<vector<long long>>(argv[0])) return aux::sum(cast<const vector<long long> &>(argv[0]));
+      if (test<vector<unsigned>>(argv[0]))  return aux::sum(cast<const vector<unsigned> &>(argv[0]));
+      MNL_ERR(MNL_SYM("TypeMismatch"));
+   }
+   val proc_Dot::invoke(val &&self, const sym &op, int argc, val argv[], val *) { // Dot[Array; Array]
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      if (MNL_LIKELY(test<vector<val>>(argv[0])))  return aux::dot(cast<const vector<val> &>(argv[0]), argv[1]);
+      if (test<vector<double>>(argv[0]))    return aux::dot(cast<const vector<double> &>(argv[0]), argv[1]);
+      if (test<vector<float>>(argv[0]))     return aux::dot(cast<const vector<float> &>(argv[0]), argv[1]);
+      if (test<vector<long long>>(argv[0])) return aux::dot(cast<const vector<long long> &>(argv[0]), argv[1]);
+      if (test<vector<unsigned>>(argv[0]))  return aux::dot(cast<const vector<unsigned> &>(argv[0]), argv[1]);
+      MNL_ERR(MNL_SYM("TypeMismatch"));
+   }
+   template<bool Max> val proc_Extremum<Max>::invoke(val &&self, const sym &op, int argc, val argv[], val *argv_out) { // Min[Array], Max[Array]
+      if (MNL_UNLIKELY(argc != 1) || MNL_UNLIKELY(op != MNL_SYM("Apply"))) { // Min[A; B], Max[A; B], etc.
+         static const val proc = Max ? val(proc_Max{}) : val(proc_Min{});
+         return op == MNL_SYM("Apply") ? proc(argc, argv, argv_out) : self.default_invoke(op, argc, argv);
+      }
+      if (MNL_LIKELY(test<vector<val>>(argv[0])))  return aux::extremum<Max>(cast<const vector<val> &>(argv[0]));
+      if (test<vector<double>>(argv[0]))    return aux::extremum<Max>(cast<const vector<double> &>(argv[0]));
+      if (test<vector<float>>(argv[0]))     return aux::extremum<Max>(cast<const vector<float> &>(argv[0]));
+      if (test<vector<long long>>(argv[0])) return aux::extremum<Max>(cast<const vector<long long> &>(argv[0]));
+      if (test<vector<unsigned>>(argv[0]))  return aux::extremum<Max>(cast<const vector<unsigned> &>(argv[0]));
+      MNL_ERR(MNL_SYM("TypeMismatch"));
+   }
+   val proc_Map2::invoke(val &&self, const sym &op, int argc, val argv[], val *) { // Map2[Op; Array; Array]
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 3)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      if (MNL_UNLIKELY(!test<vector<val>>(argv[1])) || MNL_UNLIKELY(!test<vector<val>>(argv[2]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      auto &&lhs = cast<const vector<val> &>(argv[1]), &&rhs = cast<const vector<val> &>(argv[2]);
+      if (MNL_UNLIKELY(lhs.size() != rhs.size())) MNL_ERR(MNL_SYM("ConstraintViolation"));
+      val res = MNL_LIKELY(argv[1].rc() == 1) ? move(argv[1]) : vector<val>(lhs.size());
+      auto &dat = cast<vector<val> &>(res);
+      if (MNL_LIKELY(test<sym>(argv[0]))) switch (MNL_DISP("+", "-", "*", "/")[cast<const sym &>(argv[0])]) {
+      case 1: if (aux::map2(cast<const sym &>(argv[0]), simd_add, simd_add, dat, lhs, rhs)) return res; break;
+      case 2: if (aux::map2(cast<const sym &>(argv[0]), simd_sub, simd_sub, dat, lhs, rhs)) return res; break;
+      case 3: if (aux::map2(cast<const sym &>(argv[0]), simd_mul, simd_mul, dat, lhs, rhs)) return res; break;
+      case 4: if (aux::map2(cast<const sym &>(argv[0]), simd_div, simd_div, dat, lhs, rhs)) return res; break;
+      }
+      for (size_t sn = 0; sn < dat.size(); ++sn) dat[sn] = argv[0](args<2>{lhs[sn], rhs[sn]});
+      return res;
+   }
+   template class box<proc_Sum>;
+   template class box<proc_Dot>;
+   template class box<proc_Map2>;
+   template class box<proc_Extremum<false>>;
+   template class box<proc_Extremum<true>>;
+
+} // namespace MNL_AUX_UUID
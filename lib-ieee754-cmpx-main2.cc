@@ -175,11 +175,13 @@ namespace rusini {
       char res[sizeof "+3.40282347e+38,+3.40282347e+38"];
       return sprintf(res, "%.8e,%.8e", real(rhs), imag(rhs)), res;
    }
+   template<typename Real> MNL_INLINE static inline long long _hash(const complex<Real> &rhs) noexcept
+      { return mnl::aux::_hash_combine(mnl::aux::_hash(real(rhs)), mnl::aux::_hash(imag(rhs))); }
 } // namespace rusini
 # define RUSINI_M(DAT) \
    template<> auto mnl::box<DAT>::invoke(val &&self, const sym &op, int argc, val argv[], val *)->val { \
    switch (MNL_DISP("+", "-", "*", "/", "Neg", "~", "Conj", "==", "<>", "Order", "Re", "Im", "Abs", "Arg", "Exp", "Log", "Log10", \
-      "Sqrt", "Pow", "Sin", "Cos", "Tan", "Asin", "Acos", "Atan", "Sinh", "Cosh", "Tanh", "Asinh", "Acosh", "Atanh", "Clone", "Str")[op]) { \
+      "Sqrt", "Pow", "Sin", "Cos", "Tan", "Asin", "Acos", "Atan", "Sinh", "Cosh", "Tanh", "Asinh", "Acosh", "Atanh", "Clone", "Str", "Hash")[op]) { \
    case  0: return self.default_invoke(op, argc, argv); \
       using ::std::move; namespace rus = ::rusini; using ::std::signbit; \
    case  1: /* + */ \
@@ -319,6 +321,9 @@ namespace rusini {
    case 33: /* Str */ \
       if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
       return rus::_str(dat); \
+   case 34: /* Hash */ \
+      if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
+      return rus::_hash(dat); \
    }} \
 // end # define RUSINI_M(DAT)
    RUSINI_M(::std::complex<double>) RUSINI_M(::std::complex<float>)
@@ -334,7 +339,7 @@ namespace rusini { extern "C" mnl::code mnl_aux_ieee754_cmpx() {
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
       if (MNL_LIKELY(test<long long>(argv[0]))) return (DAT)cast<long long>(argv[0]); \
       if (MNL_LIKELY(test<DAT::value_type>(argv[0]))) return (DAT)cast<DAT::value_type>(argv[0]); \
-      if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch")); \
+      if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch")); \
       \
       switch (cast<const string &>(argv[0])[0]) { \
       case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': case '.': \
@@ -121,11 +121,15 @@ namespace rusini {
       if (MNL_UNLIKELY(res < mnl::min_i48) || MNL_UNLIKELY(res > mnl::max_i48)) MNL_ERR(MNL_SYM("Overflow"));
       return res;
    }
+   template<int Width, bool Bankers> MNL_INLINE static inline long long _hash(dec<Width, Bankers> rhs) { // coarse (integral part only) but consistent with ==
+      if (isnan(rhs = quantize(trunc(rhs), (dec<Width, Bankers>)0)) || rhs == (dec<Width, Bankers>)0) return 0;
+      typename dec<Width, Bankers>::str_buf tmp; return mnl::aux::_hash(tmp, strlen(rhs.to_str(tmp)));
+   }
 } // namespace rusini
 # define RUSINI_M(DAT) \
    template<> auto mnl::box<DAT>::invoke(val &&self, const sym &op, int argc, val argv[], val *)->val { \
    switch (MNL_DISP("+", "-", "*", "/", "Neg", "~", "Fma", "==", "<>", "<", "<=", ">", ">=", "Order", "Abs", "Exp", \
-      "Log", "Log10", "Sqr", "Sqrt", "Pow", "Trunc", "Round", "Floor", "Ceil", "Clone", "Str", "Quantize", "Int")[op]) { \
+      "Log", "Log10", "Sqr", "Sqrt", "Pow", "Trunc", "Round", "Floor", "Ceil", "Clone", "Str", "Quantize", "Int", "Hash")[op]) { \
    case  0: return self.default_invoke(op, argc, argv); \
       using ::std::move; namespace rus = ::rusini; \
    case  1: /* + */ \
@@ -257,6 +261,9 @@ namespace rusini {
    case 29: /* Int */ \
       if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
       return rus::_int(dat); \
+   case 30: /* Hash */ \
+      if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
+      return rus::_hash(dat); \
    }} \
 // end # define RUSINI_M(DAT)
 # define RUSINI_T(...) __VA_ARGS__
@@ -270,7 +277,7 @@ namespace rusini { extern "C" code mnl_aux_ieee754_dec() {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv); \
       if (MNL_UNLIKELY(argc != 1)) MNL_ERR(MNL_SYM("InvalidInvocation")); \
       if (MNL_LIKELY(test<long long>(argv[0]))) { char res[sizeof "+140737488355327"]; return sprintf(res, "%lld", cast<long long>(argv[0])), (DAT)res; } \
-      if (MNL_LIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch")); \
+      if (MNL_LIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch")); \
       switch (cast<const string &>(argv[0])[0]) { \
       case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9': case '.': \
          break; \
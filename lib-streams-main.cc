@@ -26,7 +26,7 @@
 
 extern "C" mnl::code mnl_main() {
    using std::string;
-   using mnl::sym; using mnl::val; using mnl::test; using mnl::cast;
+   using mnl::sym; using mnl::val; using mnl::test; using mnl::cast; using mnl::string_slice;
    using mnl::make_lit; using mnl::expr_export; using mnl::make_proc_test;
 
    class stream {
@@ -47,7 +47,11 @@ extern "C" mnl::code mnl_main() {
                if (MNL_UNLIKELY(prev_op == read) && MNL_UNLIKELY(::fseek(fp, {}, SEEK_CUR))) MNL_ERR(MNL_SYM("SystemError")); prev_op = write;
                for (int sn = 0; sn < argc; ++sn) {
                   auto res = MNL_SYM("Str")(argv[sn]);
-                  if (MNL_UNLIKELY(!test<string>(res))) MNL_ERR(MNL_SYM("TypeMismatch"));
+                  if (MNL_UNLIKELY(test<string_slice>(res))) { // no materialization
+                     if (MNL_UNLIKELY(!::fwrite(cast<const string_slice &>(res).data(), cast<const string_slice &>(res).size, 1, fp))) MNL_ERR(MNL_SYM("SystemError"));
+                     continue;
+                  }
+                  if (MNL_UNLIKELY(!res.box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
                   if (MNL_LIKELY(cast<const string &>(res).size()) &&
                      MNL_UNLIKELY(!::fwrite(cast<const string &>(res).c_str(), cast<const string &>(res).size(), 1, fp))) MNL_ERR(MNL_SYM("SystemError"));
                }
@@ -61,7 +65,11 @@ extern "C" mnl::code mnl_main() {
                if (MNL_UNLIKELY(prev_op == read) && MNL_UNLIKELY(::fseek(fp, {}, SEEK_CUR))) MNL_ERR(MNL_SYM("SystemError")); prev_op = write;
                for (int sn = 0; sn < argc; ++sn) {
                   auto res = MNL_SYM("Str")(argv[sn]);
-                  if (MNL_UNLIKELY(!test<string>(res))) MNL_ERR(MNL_SYM("TypeMismatch"));
+                  if (MNL_UNLIKELY(test<string_slice>(res))) { // no materialization
+                     if (MNL_UNLIKELY(!::fwrite(cast<const string_slice &>(res).data(), cast<const string_slice &>(res).size, 1, fp))) MNL_ERR(MNL_SYM("SystemError"));
+                     continue;
+                  }
+                  if (MNL_UNLIKELY(!res.box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
                   if (MNL_LIKELY(cast<const string &>(res).size()) &&
                      MNL_UNLIKELY(!::fwrite(cast<const string &>(res).c_str(), cast<const string &>(res).size(), 1, fp))) MNL_ERR(MNL_SYM("SystemError"));
                }
@@ -100,7 +108,7 @@ extern "C" mnl::code mnl_main() {
                res.resize(::fread(&res.front(), 1, cast<long long>(argv[0]), fp)); if (MNL_UNLIKELY(::ferror(fp))) MNL_ERR(MNL_SYM("SystemError")); return res;
                MNL_IF_WITH_MT(}();)
             } else {
-               if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+               if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
                MNL_IF_WITH_MT(return std::lock_guard<std::mutex>(mutex), [&]()->val{)
                if (MNL_UNLIKELY(!fp)) MNL_ERR(MNL_SYM("ConstraintViolation"));
                struct _ { ::FILE *fp; MNL_INLINE ~_() { ::funlockfile(fp); } } _{(::flockfile(fp), fp)}; ::clearerr(fp);
@@ -134,7 +142,7 @@ extern "C" mnl::code mnl_main() {
                MNL_IF_WITH_MT(}();)
             }
             if (MNL_LIKELY(argc == 1)) {
-               if (MNL_UNLIKELY(!test<string>(argv[0]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+               if (MNL_UNLIKELY(!argv[0].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
                MNL_IF_WITH_MT(return std::lock_guard<std::mutex>(mutex), [&]()->val{)
                if (MNL_UNLIKELY(!fp)) MNL_ERR(MNL_SYM("ConstraintViolation"));
                struct _ { ::FILE *fp; MNL_INLINE ~_() { ::funlockfile(fp); } } _{(::flockfile(fp), fp)}; ::clearerr(fp);
@@ -225,7 +233,7 @@ extern "C" mnl::code mnl_main() {
    struct proc_OpenFile { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-      if (MNL_UNLIKELY(!test<string>(argv[0])) || MNL_UNLIKELY(!test<string>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string()) || MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       auto fp = ::fopen(cast<const string &>(argv[0]).c_str(), cast<const string &>(argv[1]).c_str());
       if (MNL_UNLIKELY(!fp)) MNL_ERR(MNL_SYM("SystemError"));
       return stream{fp, [](::FILE *fp)noexcept{ ::fclose(fp); }, [](::FILE *fp)->val{
@@ -234,7 +242,7 @@ extern "C" mnl::code mnl_main() {
    struct proc_OpenPipe { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
       if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
       if (MNL_UNLIKELY(argc != 2)) MNL_ERR(MNL_SYM("InvalidInvocation"));
-      if (MNL_UNLIKELY(!test<string>(argv[0])) || MNL_UNLIKELY(!test<string>(argv[1]))) MNL_ERR(MNL_SYM("TypeMismatch"));
+      if (MNL_UNLIKELY(!argv[0].box_string()) || MNL_UNLIKELY(!argv[1].box_string())) MNL_ERR(MNL_SYM("TypeMismatch"));
       auto fp = ::popen(cast<const string &>(argv[0]).c_str(), cast<const string &>(argv[1]).c_str());
       if (MNL_UNLIKELY(!fp)) MNL_ERR(MNL_SYM("SystemError"));
       return stream{fp, [](::FILE *fp)noexcept{ ::pclose(fp); }, [](::FILE *fp)->val{
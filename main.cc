@@ -58,7 +58,7 @@ namespace aux { namespace {
          auto saved_tmp_cnt = move(tmp_cnt); tmp_cnt = 0;
          auto saved_tmp_ids = move(tmp_ids); tmp_ids.clear();
 
-         auto path = compile_rval(form[1], _loc).execute(); if (!test<string>(path)) err_compile("type mismatch", _loc);
+         auto path = compile_rval(form[1], _loc).execute(); if (!path.box_string()) err_compile("type mismatch", _loc);
 
          tmp_ids = move(saved_tmp_ids);
          tmp_cnt = move(saved_tmp_cnt);
@@ -202,6 +202,24 @@ namespace aux { extern "C" code mnl_aux_runtime() {
       if (MNL_UNLIKELY(cast<long long>(argv[0]) < 0)) MNL_ERR(MNL_SYM("ConstraintViolation"));
       return heap_reserve(cast<long long>(argv[0]));
    }};
+   struct proc_HeapStats    { MNL_INLINE static val invoke(val &&self, const sym &op, int argc, val argv[], val *) {
+      if (MNL_UNLIKELY(op != MNL_SYM("Apply"))) return self.default_invoke(op, argc, argv);
+      if (MNL_UNLIKELY(argc != 0)) MNL_ERR(MNL_SYM("InvalidInvocation"));
+      static const record_descr
+         descr{"Current", "Peak", "AllocCount", "FreeCount", "SizeClasses"}, class_descr{"MaxSize", "AllocCount", "FreeCount"};
+      auto stats = heap_stats();
+      val classes = vector<val>{}; cast<vector<val> &>(classes).reserve(sizeof stats.size_class / sizeof *stats.size_class);
+      for (auto &&el: stats.size_class) {
+         _record<0x3> rec{class_descr};
+         rec[(MNL_SYM("MaxSize"))] = el.max_size, rec[(MNL_SYM("AllocCount"))] = el.alloc_count, rec[(MNL_SYM("FreeCount"))] = el.free_count;
+         cast<vector<val> &>(classes).push_back(move(rec));
+      }
+      _record<0x5> res{descr};
+      res[(MNL_SYM("Current"))]    = stats.current,     res[(MNL_SYM("Peak"))]      = stats.peak;
+      res[(MNL_SYM("AllocCount"))] = stats.alloc_count, res[(MNL_SYM("FreeCount"))] = stats.free_count;
+      res[(MNL_SYM("SizeClasses"))] = move(classes);
+      return move(res);
+   }};
    return expr_export{
       {"ProcessArgv", make_lit([]()->val{
          val res = vector<val>{};
@@ -218,6 +236,7 @@ namespace aux { extern "C" code mnl_aux_runtime() {
       {"ProcessExit",  make_lit(proc_ProcessExit {})},
       {"ReserveStack", make_lit(proc_ReserveStack{})},
       {"ReserveHeap",  make_lit(proc_ReserveHeap {})},
+      {"HeapStats",    make_lit(proc_HeapStats   {})},
    };
 }}
 
@@ -23,16 +23,32 @@ namespace MNL_AUX_UUID { using namespace aux;
    namespace aux {
       using std::_Exit; // <cstdlib>
       using std::fprintf; using std::fflush; // <cstdio>
+      using std::make_shared; // <memory>
       using std::deque;
    }
 
    // Compile-time accounting
    MNL_IF_WITH_MT(thread_local) decltype(tmp_cnt) pub::tmp_cnt; // count for current frame layout
+   MNL_IF_WITH_MT(thread_local) decltype(tmp_max) pub::tmp_max; // high-water mark of tmp_cnt
    MNL_IF_WITH_MT(thread_local) decltype(tmp_ids) pub::tmp_ids; // all temporaries
+   MNL_IF_WITH_MT(thread_local) decltype(tail_form) pub::tail_form; // application in tail position
    // Run-time accounting
    MNL_IF_WITH_MT(thread_local) decltype(tmp_stk) pub::tmp_stk; // stack
    MNL_IF_WITH_MT(thread_local) decltype(tmp_frm) pub::tmp_frm; // frame pointer
 
+   pub::tmp_stack::tmp_stack(): top{}, lim{}, tail{} { next(seg_size), tmp_frm = top; } // root frame (temporaries are always allocated before use)
+   pub::tmp_stack::~tmp_stack() { for (auto &&el: segs) delete[] el.first; }
+
+   void pub::tmp_stack::next(int size) {
+      decltype(segs.size()) sn = 0; while (sn < segs.size() && segs[sn++].second != lim); // past the current segment (if any)
+      if (sn == segs.size() || segs[sn].second - segs[sn].first < size) { // insert a fresh one there (too small segments stay for later use)
+         auto seg_size = size > this->seg_size ? size : (int)this->seg_size;
+         segs.reserve(segs.size() + 1); auto base = new val[seg_size]; segs.insert(segs.begin() + sn, make_pair(base, base + seg_size));
+      }
+      top = segs[sn].first, lim = segs[sn].second;
+   }
+   void pub::tmp_stack::overflow() { MNL_ERR(MNL_SYM("LimitExceeded")); }
+
    namespace aux {
       code optimize(expr_lit<>);
       code optimize(expr_apply0<>), optimize(expr_apply1<>), optimize(expr_apply2<>), optimize(expr_apply3<>), optimize(expr_apply4<>);
@@ -40,6 +56,114 @@ namespace MNL_AUX_UUID { using namespace aux;
 
    code pub::make_lit(const val &value) { return optimize(expr_lit<>{value}); }
 
+   bool aux::match_lit(const code &expr, val &value) {
+      if (test<expr_lit<>>(expr)) return value = cast<const expr_lit<> &>(expr).value, true;
+   # define MNL_M(TYPE) if (test<expr_lit<TYPE>>(expr)) return value = cast<const expr_lit<TYPE> &>(expr).value, true;
+      MNL_M(long long) MNL_M(double) MNL_M(float) MNL_M(const sym &) MNL_M(bool) MNL_M(decltype(nullptr)) MNL_M(unsigned) // see optimize(expr_lit<>)
+   # undef MNL_M
+      return false;
+   }
+
+   namespace aux { namespace {
+      // Operations that are pure (no side effects and no dependence on state) when applied to plain values
+      const set<sym> &pure_ops() {
+         static const set<sym> res{
+            MNL_SYM("+"),   MNL_SYM("-"),   MNL_SYM("*"),   MNL_SYM("/"),    MNL_SYM("Div"),  MNL_SYM("Mod"),   MNL_SYM("Rem"),   MNL_SYM("Neg"),
+            MNL_SYM("Abs"), MNL_SYM("&"),   MNL_SYM("|"),   MNL_SYM("~"),    MNL_SYM("Xor"),  MNL_SYM("Shl"),   MNL_SYM("Shr"),   MNL_SYM("Ashr"),
+            MNL_SYM("Rotl"), MNL_SYM("Rotr"), MNL_SYM("Ctz"), MNL_SYM("Clz"), MNL_SYM("C1s"), MNL_SYM("Log2"),  MNL_SYM("=="),    MNL_SYM("<>"),
+            MNL_SYM("<"),   MNL_SYM("<="),  MNL_SYM(">"),   MNL_SYM(">="),   MNL_SYM("Order"), MNL_SYM("Str"),  MNL_SYM("Int"),   MNL_SYM("Size"),
+            MNL_SYM("Sqr"), MNL_SYM("Sqrt"), MNL_SYM("Sign"), MNL_SYM("Trunc"), MNL_SYM("Round"), MNL_SYM("Floor"), MNL_SYM("Ceil"),
+         };
+         return res;
+      }
+      // Whether an application is safe to evaluate in advance (at compile time or once per loop entry), judging by the actual target and arguments
+      bool is_pure(const val &target, int argc, const val argv[]) {
+         static const auto plain = [](const val &arg){ return test<long long>(arg) || test<double>(arg) || test<float>(arg) ||
+            test<unsigned>(arg) || test<bool>(arg) || test<sym>(arg) || arg.is_string(); }; // Arrays may hold objects, whose operations may have effects
+         if (test<vector<val>>(target) || target.is_string()) return argc == 1 && plain(argv[0]); // element access (A[I])
+         if (!test<sym>(target) || !argc || !pure_ops().count(cast<const sym &>(target))) return false;
+         if (cast<const sym &>(target) == MNL_SYM("Size") && argc == 1 && test<vector<val>>(argv[0])) return true;
+         for (int sn = 0; sn < argc; ++sn) if (!plain(argv[sn])) return false;
+         return true;
+      }
+
+      // Loop-invariant hoisting (see hoist_loop) ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+      struct hoist_ref { // where a hoisted application keeps its value: entry ix of the vector held in the temporary off (off < 0: not hoisted)
+         int off = -1, ix; shared_ptr<const int> size; // size: final number of entries for the loop
+      };
+      struct loop_ctx {
+         loop_ctx *outer; int base; // base: tmp_cnt on loop entry (the temporary that holds the hoisted values)
+         bool opaque; // assignments out of sight
+         vector<pair<code, int>> tmps; vector<bool> written; // temporaries in scope on loop entry (compared by identity), and which ones are assigned
+         vector<pair<vector<int>, shared_ptr<hoist_ref>>> cands; map<const form *, int> cand_ix; // invariant candidates, with temporaries they depend on
+      };
+      MNL_IF_WITH_MT(thread_local) loop_ctx *loop_top; // innermost loop being compiled
+
+      // Record the root temporary assigned through an L-value form (conservatively, the whole loop becomes opaque for unrecognized forms)
+      void note_write(const form &form) {
+         auto mark = [](const code &expr){
+            val value; bool found = false;
+            for (auto ctx = loop_top; ctx; ctx = ctx->outer) for (auto &&el: ctx->tmps) if (el.first == expr) ctx->written[el.second] = found = true;
+            if (!found && !test<expr_tmp>(expr) && !match_lit(expr, value)) hoist_barrier();
+         };
+         for (auto el = &form;;) {
+            if (test<sym>(*el) && symtab[cast<const sym &>(*el)]) return mark(symtab[cast<const sym &>(*el)]);
+            if (!el->is_list() || el->empty()) return hoist_barrier();
+            if (el->front().is_list()) { el = &el->front(); continue; }
+            if (test<sym>(el->front()) && symtab[cast<const sym &>(el->front())] && test<expr_tmp>(symtab[cast<const sym &>(el->front())]))
+               return mark(symtab[cast<const sym &>(el->front())]);
+            return hoist_barrier();
+         }
+      }
+      // Record the application as an invariant candidate for each enclosing loop where it qualifies; the binding is decided in hoist_loop
+      shared_ptr<hoist_ref> hoist(const form &form, const code &target, const vector<code> &args) {
+         {  val value; if (match_lit(target, value) && (!test<sym>(value) || !pure_ops().count(cast<const sym &>(value)))) return {};
+         }
+         shared_ptr<hoist_ref> ref;
+         for (auto ctx = loop_top; ctx; ctx = ctx->outer) {
+            {  auto it = ctx->cand_ix.find(&form); if (it != ctx->cand_ix.end()) { ref = ctx->cands[it->second].second; continue; } // compiled again
+            }
+            vector<int> reads; auto invariant = [&](const mnl::form &form, const code &expr)->bool{
+               val value; if (match_lit(expr, value)) return true;
+               for (auto &&el: ctx->tmps) if (el.first == expr) return reads.push_back(el.second), true;
+               auto it = ctx->cand_ix.find(&form); if (it == ctx->cand_ix.end()) return false;
+               reads.insert(reads.end(), ctx->cands[it->second].first.begin(), ctx->cands[it->second].first.end()); return true;
+            };
+            if (!invariant(form.front(), target)) continue;
+            for (int sn = 0; sn < (int)args.size(); ++sn) if (!invariant(form[sn + 1], args[sn])) goto next;
+            if (!reads.empty()) { // only loop-dependent ones
+               if (!ref) ref = make_shared<hoist_ref>();
+               ctx->cand_ix.insert({&form, ctx->cands.size()}), ctx->cands.push_back({move(reads), ref});
+            }
+         next:;
+         }
+         return ref;
+      }
+
+      struct expr_hoisted { MNL_LVALUE(expr.is_lvalue()) // an L-value one never gets hoisted (its root temporary is assigned)
+         shared_ptr<const hoist_ref> ref; code expr, target; vector<code> args; loc _loc; // expr: the application as compiled normally
+         struct impure { MNL_INLINE val invoke(val &&self, const sym &op, int argc, val argv[], val *) { return self.default_invoke(op, argc, argv); } };
+      public:
+         MNL_INLINE void exec_in(val &&value) const { expr.exec_in(move(value)); }
+         MNL_INLINE val exec_out() const { return expr.exec_out(); }
+         MNL_INLINE val execute(bool) const {
+            auto &&ref = *this->ref; if (MNL_UNLIKELY(ref.off < 0)) return expr.execute();
+            auto &&cell = tmp_frm[ref.off]; // nil on loop entry, so the order of evaluation and signaling is as without hoisting
+            if (MNL_LIKELY(cell != nullptr)) {
+               auto &&value = cast<const vector<val> &>(cell)[ref.ix];
+               if (MNL_LIKELY(value != nullptr)) return MNL_LIKELY(!test<impure>(value)) ? value : expr.execute();
+            }
+            int argc = args.size(); val argv[4];
+            for (int sn = 0; sn < argc; ++sn) args[sn].execute().swap(argv[sn]); val target = this->target.execute();
+            bool pure = is_pure(target, argc, argv); val res;
+            try { res = move(target)(argc, argv); } catch (...) { trace_execute(_loc); }
+            auto &&_cell = tmp_frm[ref.off]; if (_cell == nullptr) _cell = vector<val>(*ref.size); // (the frame is the same after the application)
+            if (pure) cast<vector<val> &>(_cell)[ref.ix] = res; else cast<vector<val> &>(_cell)[ref.ix] = impure{}; // otherwise, as without hoisting
+            return res;
+         }
+      };
+   }}
+
    code aux::compile_apply(code &&target, const form &form, const loc &_loc) {
       if (form.size() - 1 > val::max_argc) MNL_ERR(MNL_SYM("LimitExceeded"));
    opt1: // Application without input/output arguments
@@ -48,12 +172,46 @@ namespace MNL_AUX_UUID { using namespace aux;
       {  vector<code> args; args.reserve(form.size() - 1);
          for (auto &&el: form + 1) args.push_back(compile_rval(el, _loc));
 
+         {  val target_value; vector<val> argv(args.size()); // constant folding
+            if (match_lit(target, target_value) && [&]()->bool{
+               for (int sn = 0; sn < (int)args.size(); ++sn) if (!match_lit(args[sn], argv[sn])) return false; return true; }() &&
+               is_pure(target_value, argv.size(), argv.data()))
+            try { return make_lit(move(target_value)(argv.size(), argv.data())); } catch (...) {} // otherwise, signal at run time
+         }
+         if (MNL_UNLIKELY(loop_top) && args.size() <= 4) { // loop-invariant application
+            auto ref = hoist(form, target, args); if (ref) switch (args.size()) {
+            case 0: return expr_hoisted{ref, optimize(expr_apply0<>{target, _loc}), target, args, _loc};
+            case 1: return expr_hoisted{ref, optimize(expr_apply1<>{target, args[0], _loc}), target, args, _loc};
+            case 2: return expr_hoisted{ref, optimize(expr_apply2<>{target, args[0], args[1], _loc}), target, args, _loc};
+            case 3: return expr_hoisted{ref, optimize(expr_apply3<>{target, args[0], args[1], args[2], _loc}), target, args, _loc};
+            case 4: return expr_hoisted{ref, optimize(expr_apply4<>{target, args[0], args[1], args[2], args[3], _loc}), target, args, _loc};
+            }
+         }
+         if (MNL_UNLIKELY(&form == tail_form) && args.size() <= tmp_stack::max_tail_argc && [&]()->bool{
+            val value; return !match_lit(target, value) || test<proc>(value); }()) { // leave calls to procedures for the trampoline
+            struct expr_tail { MNL_RVALUE()
+               code target; vector<code> args; loc _loc; apply_cache _cache;
+            public:
+               MNL_INLINE val execute(bool) const {
+                  int argc = args.size(); val argv[tmp_stack::max_tail_argc];
+                  for (int sn = 0; sn < argc; ++sn) args[sn].execute().swap(argv[sn]); val target = this->target.execute();
+                  if (MNL_UNLIKELY(!test<proc>(target))) try { return _cache(move(target), argc, argv); } catch (...) { trace_execute(_loc); }
+                  MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk;)
+                  tmp_stk.tail.target = move(target), tmp_stk.tail.argc = argc;
+                  for (int sn = 0; sn < argc; ++sn) tmp_stk.tail.argv[sn].swap(argv[sn]);
+                  tmp_stk.tail._loc = &_loc, tmp_stk.tail.frame = tmp_frm, tmp_stk.tail.pending = true;
+                  return {};
+               }
+            };
+            return expr_tail{move(target), move(args), _loc};
+         }
+
          struct expr_apply5 { MNL_LVALUE(target.is_lvalue())
-            code target, a0, a1, a2, a3, a4; loc _loc;
+            code target, a0, a1, a2, a3, a4; loc _loc; apply_cache _cache;
          public:
             MNL_INLINE val execute(bool) const {
                val argv[]{a0.execute(), a1.execute(), a2.execute(), a3.execute(), a4.execute()}, target = this->target.execute();
-               try { return move(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+               try { return _cache(move(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
             }
             MNL_INLINE void exec_in(val &&value) const {
                target.exec_in([&]()->val{
@@ -73,11 +231,11 @@ namespace MNL_AUX_UUID { using namespace aux;
             }
          };
          struct expr_apply6 { MNL_LVALUE(target.is_lvalue())
-            code target, a0, a1, a2, a3, a4, a5; loc _loc;
+            code target, a0, a1, a2, a3, a4, a5; loc _loc; apply_cache _cache;
          public:
             MNL_INLINE val execute(bool) const {
                val argv[]{a0.execute(), a1.execute(), a2.execute(), a3.execute(), a4.execute(), a5.execute()}, target = this->target.execute();
-               try { return move(target)(std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
+               try { return _cache(move(target), std::extent<decltype(argv)>::value, argv); } catch (...) { trace_execute(_loc); }
             }
             MNL_INLINE void exec_in(val &&value) const {
                target.exec_in([&]()->val{
@@ -106,13 +264,13 @@ namespace MNL_AUX_UUID { using namespace aux;
          case 6: return expr_apply6{move(target), move(args[0]), move(args[1]), move(args[2]), move(args[3]), move(args[4]), move(args[5]), _loc};
          }
          struct expr_apply { MNL_LVALUE(target.is_lvalue())
-            code target; vector<code> args; loc _loc; // implementation-defined destruction order for "args"
+            code target; vector<code> args; loc _loc; apply_cache _cache; // implementation-defined destruction order for "args"
          public:
             MNL_INLINE val execute(bool) const {
                int argc = args.size(); auto args = this->args.data();
                val argv[argc];
                for (int sn = 0; sn < argc; ++sn) args[sn].execute().swap(argv[sn]); val target = this->target.execute();
-               try { return move(target)(argc, argv); } catch (...) { trace_execute(_loc); }
+               try { return _cache(move(target), argc, argv); } catch (...) { trace_execute(_loc); }
             }
             MNL_INLINE void exec_in(val &&value) const {
                int argc = args.size(); auto args = this->args.data();
@@ -372,6 +530,7 @@ namespace MNL_AUX_UUID { using namespace aux;
    code pub::compile_lval(const form &form, const loc &_loc) {
       auto res = compile(form, _loc);
       if (!res.is_lvalue()) err_compile("not an L-value expression (nested in this context)", _loc);
+      if (MNL_UNLIKELY(loop_top)) note_write(form);
       return res;
    }
    sym  pub::eval_sym(const form &form, const loc &_loc) {
@@ -380,30 +539,61 @@ namespace MNL_AUX_UUID { using namespace aux;
       return cast<const sym &>(res);
    }
    code pub::compile_rval(form::vci_range range, const loc &_loc) {
-      struct expr_seq { MNL_LVALUE(second.is_lvalue())
-         code first, second;
-         MNL_INLINE val execute(bool fast_sig) const { if (MNL_UNLIKELY(first.execute(fast_sig), sig_state.first)) return {}; return second.execute(fast_sig); }
-         MNL_INLINE void exec_in(val &&value) const { first.execute(); second.exec_in(move(value)); }
-         MNL_INLINE val exec_out() const { first.execute(); return second.exec_out(); }
-      };
       auto res = compile_rval(*range.begin(), _loc);
       for (auto &&el: form::vci_range{range.begin() + 1, range.end()}) res = expr_seq{move(res), compile_rval(el, _loc)};
+      if (MNL_UNLIKELY(use_bytecode) && !res.is_lvalue()) res = lower_bytecode(move(res)); // bodies of procedures, loops, etc.
       return res;
    }
 
+   code aux::hoist_loop(code (*compile)(const form &, const loc &), const form &form, const loc &_loc) {
+      loop_ctx ctx{loop_top, tmp_cnt};
+      for (auto &&el: tmp_ids) if (symtab[el] && test<expr_tmp>(symtab[el])) ctx.tmps.push_back({symtab[el], cast<const expr_tmp &>(symtab[el]).off});
+      ctx.written.resize(ctx.base);
+      struct _ { loop_ctx *saved; MNL_INLINE ~_() { loop_top = saved; } } _{loop_top}; loop_top = &ctx;
+
+      if (tmp_cnt == lim<decltype(tmp_cnt)>::max()) MNL_ERR(MNL_SYM("LimitExceeded"));
+      if (++tmp_cnt > tmp_max) tmp_max = tmp_cnt;
+      auto body = compile(form, _loc); // the loop is compiled only once (compile-time evaluation happens just as without hoisting)
+      --tmp_cnt;
+      auto size = make_shared<int>(0);
+      if (!ctx.opaque) for (auto &&el: ctx.cands) { // enclosing loops are processed later, so the outermost one wins
+         for (auto &&off: el.first) if (ctx.written[off]) goto next;
+         el.second->off = ctx.base, el.second->ix = (*size)++, el.second->size = size;
+      next:;
+      }
+
+      struct expr { MNL_RVALUE()
+         code body;
+      public:
+         MNL_INLINE val execute(bool fast_sig) const { // the hoisted values are computed on demand (see expr_hoisted)
+            MNL_IF_WITH_MT(auto &tmp_stk = mnl::tmp_stk;)
+            tmp_stk.alloc(1); struct _ { tmp_stack &stk; MNL_INLINE ~_() { stk.pop(); } } _{tmp_stk};
+            return body.execute(fast_sig);
+         }
+      };
+      return expr{move(body)};
+   }
+   void aux::hoist_barrier() {
+      for (auto ctx = loop_top; ctx; ctx = ctx->outer) ctx->opaque = true;
+   }
+
    int val::default_order(const val &rhs) const noexcept {
       auto mask1 = MNL_AUX_RAND(unsigned);
       auto mask2 = MNL_AUX_RAND(size_t);
       bool mask3 = MNL_AUX_RAND(unsigned) & 1;
+      // short Strings (tag 0xFFF8u) and String slices are ordered among other values exactly as box<string>
+      static const auto tag = [](const val &rhs)->unsigned
+         { return rhs.rep.tag() == 0xFFF8u ? 0x7FF8u : ~rhs.rep.tag() & 0x7FF0u ? 0 : rhs.rep.tag(); };
+      static const auto type = [](const val &rhs)->const std::type_info &
+         { return rhs.rep.tag() == 0xFFF8u || rhs.test<string_slice>() ? typeid(box<string>) : typeid(*static_cast<root *>(rhs.rep.dat<void *>())); };
       return
-      MNL_LIKELY(rep.tag() != 0x7FF8u) || MNL_LIKELY(rhs.rep.tag() != 0x7FF8u) ?
-         (((~rep.tag() & 0x7FF0u ? 0 : rep.tag()) ^ mask1) < ((~rhs.rep.tag() & 0x7FF0u ? 0 : rhs.rep.tag()) ^ mask1)) -
-         (((~rhs.rep.tag() & 0x7FF0u ? 0 : rhs.rep.tag()) ^ mask1) < ((~rep.tag() & 0x7FF0u ? 0 : rep.tag()) ^ mask1)) :
+      MNL_LIKELY(tag(*this) != 0x7FF8u) || MNL_LIKELY(tag(rhs) != 0x7FF8u) ?
+         ((tag(*this) ^ mask1) < (tag(rhs) ^ mask1)) - ((tag(rhs) ^ mask1) < (tag(*this) ^ mask1)) :
       MNL_LIKELY(!test<object>()) || MNL_LIKELY(!rhs.test<object>()) ?
-         (typeid(*static_cast<root *>(rep.dat<void *>())).hash_code() ^ mask2) < (typeid(*static_cast<root *>(rhs.rep.dat<void *>())).hash_code() ^ mask2) ? -1 :
-         (typeid(*static_cast<root *>(rhs.rep.dat<void *>())).hash_code() ^ mask2) < (typeid(*static_cast<root *>(rep.dat<void *>())).hash_code() ^ mask2) ? +1 :
-         typeid(*static_cast<root *>(rep.dat<void *>())).before(typeid(*static_cast<root *>(rhs.rep.dat<void *>()))) ? mask3 ? -1 : +1 :
-         typeid(*static_cast<root *>(rhs.rep.dat<void *>())).before(typeid(*static_cast<root *>(rep.dat<void *>()))) ? mask3 ? +1 : -1 : 0 :
+         (type(*this).hash_code() ^ mask2) < (type(rhs).hash_code() ^ mask2) ? -1 :
+         (type(rhs).hash_code() ^ mask2) < (type(*this).hash_code() ^ mask2) ? +1 :
+         type(*this).before(type(rhs)) ? mask3 ? -1 : +1 :
+         type(rhs).before(type(*this)) ? mask3 ? +1 : -1 : 0 :
       // else
          order(cast<const object &>().descr, rhs.cast<const object &>().descr);
    }
@@ -422,8 +612,8 @@ namespace MNL_AUX_UUID { using namespace aux;
    void aux::panic(const decltype(sig_state) &sig) {
       if (sig.first == MNL_SYM("CompileError")) { // should be uninterned?
          sig_trace.clear();
-         if (!test<string>(sig.second)) panic({MNL_SYM("TypeMismatch"), {}});
-         fprintf(stderr, "%s\n", cast<const string &>(sig.second).c_str());
+         auto msg = sig.second; if (!msg.box_string()) panic({MNL_SYM("TypeMismatch"), {}});
+         fprintf(stderr, "%s\n", cast<const string &>(msg).c_str());
       } else {
          fprintf(stderr, "Uncaught signal %s\n", (const char *)sig.first);
          if (sig_trace.empty())
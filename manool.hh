@@ -60,10 +60,34 @@ namespace aux { namespace pub {
 
    // Compile-time accounting
    extern MNL_IF_WITH_MT(thread_local) int      tmp_cnt; // count for current frame layout
+   extern MNL_IF_WITH_MT(thread_local) int      tmp_max; // high-water mark of tmp_cnt (frame size reserved by procedures)
    extern MNL_IF_WITH_MT(thread_local) set<sym> tmp_ids; // all temporaries
+   extern MNL_IF_WITH_MT(thread_local) const form *tail_form; // application (if any) in tail position of the procedure body being compiled
    // Run-time accounting
-   extern MNL_IF_WITH_MT(thread_local) vector<val>                  tmp_stk; // stack
-   extern MNL_IF_WITH_MT(thread_local) decltype(tmp_stk)::size_type tmp_frm; // frame pointer
+   class tmp_stack { // segmented and never relocated, so a reserved frame stays contiguous and addressable through a plain pointer
+   public:
+      val *top, *lim; // bump pointer and end of current segment (all slots in [top, lim) are nil)
+      tmp_stack(); ~tmp_stack();
+      // Reserve a whole frame in one bump (moving on to the next segment if the current one is short of room); release by resetting top and lim
+      MNL_INLINE val *frame(int size) { if (MNL_UNLIKELY(lim - top < size)) next(size); return top; }
+      // Push/pop temporaries inside the current frame (within the room reserved for it)
+      MNL_INLINE void alloc(int size) { if (MNL_UNLIKELY(lim - top < size)) overflow(); top += size; }
+      MNL_INLINE void push(val &&value) { if (MNL_UNLIKELY(top == lim)) overflow(); *top++ = move(value); }
+      MNL_INLINE void pop() noexcept { top[-1] = {}, --top; } // release first (a cleanup procedure may run and reserve its frame at top)
+      MNL_INLINE void pop(int size) noexcept { for (; size; --size) pop(); }
+   public:
+      enum { max_tail_argc = 4 };
+      struct { // call left by an application in tail position for the trampoline of the enclosing procedure (see comp_proc)
+         bool pending; val target; int argc; val argv[max_tail_argc]; const loc *_loc;
+         const val *frame; // of the procedure whose body left the call (only its own trampoline may take it)
+      } tail;
+   private:
+      vector<pair<val *, val *>> segs; // in stack order
+      enum { seg_size = 1 << 14 };
+      void next(int); MNL_NORETURN static void overflow();
+   };
+   extern MNL_IF_WITH_MT(thread_local) tmp_stack tmp_stk; // stack
+   extern MNL_IF_WITH_MT(thread_local) val      *tmp_frm; // frame pointer
 
    // Essential Stuff //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    code make_lit(const val &);
@@ -98,7 +122,15 @@ namespace aux { namespace pub {
 
 namespace aux { // Helper Stuff ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    code compile_apply(code &&, const form &, const loc &);
+   bool match_lit(const code &, val &); // fetch the value of literal code (for constant folding)
+   // Loop-invariant hoisting: compile a loop construct (once) reserving a temporary for a per-entry cache, so applications of pure operations
+   // that turn out to depend only on unassigned temporaries get evaluated once after loop entry
+   code hoist_loop(code (*)(const form &, const loc &), const form &, const loc &);
+   void hoist_barrier(); // for constructs that may assign temporaries in an untraceable way
    MNL_NORETURN void panic(const decltype(sig_state) &);
+   // Register bytecode backend for R-value bodies (selected by MNL_BYTECODE; disables tree specialization, since lowering works on generic nodes)
+   extern const bool use_bytecode;
+   code lower_bytecode(code &&);
 } // namespace aux
 
 } // namespace MNL_AUX_UUID
@@ -16,7 +16,7 @@
 # include "config.tcc"
 # include "mnl-misc-memmgm.hh"
 
-# include <stdlib.h> // ::malloc, ::free
+# include <stdlib.h> // ::malloc, ::aligned_alloc, ::free
 # if __linux__
    # include <malloc.h> // ::malloc_usable_size
 # elif __FreeBSD__
@@ -24,12 +24,19 @@
 # else
    # error "Either __linux__ or __FreeBSD__ is required"
 # endif
+# include <algorithm> // sort, binary_search, max
 # include <cerrno>
+# include <cstdint>  // uintptr_t
 # include <cstdlib>  // size_t, _Exit, EXIT_FAILURE
 # include <cstdio>   // stderr, fprintf, fflush, perror
+# if MNL_WITH_MULTITHREADING
+   # include <mutex>
+# endif
 
 namespace MNL_AUX_UUID { using namespace aux;
    namespace aux {
+      using std::sort; using std::binary_search; using std::max; // <algorithm>
+      using std::uintptr_t; // <cstdint>
       using std::size_t;  using std::_Exit; // <cstdlib>
       using std::fprintf; using std::fflush; using std::perror; // <cstdio>
    }
@@ -41,6 +48,19 @@ namespace aux { namespace {
    /*atomic*/ size_t heap_use;
    long long heap_lim = 1ll << 47;
    MNL_IF_WITH_MT(thread_local) long long heap_res;
+# if MNL_WITH_MULTITHREADING
+   // Threads take heap_use in chunks of up to heap_slk bytes in advance and give it back in chunks, so heap_lim may be hit early by at most
+   // 2 * heap_slk bytes per thread
+   /*atomic*/ long long heap_slk =
+   # ifdef MNL_HEAP_SLACK
+      MNL_HEAP_SLACK;
+   # else
+      256 * 1024; // 256 KiB
+   # endif
+   thread_local long long heap_crd; // credit already accounted for in heap_use but not yet used by the thread
+   MNL_INLINE inline void _heap_flush() noexcept
+      { if (heap_crd) __atomic_sub_fetch(&heap_use, heap_crd, __ATOMIC_RELAXED), heap_crd = 0; }
+# endif // # if MNL_WITH_MULTITHREADING
 }} // namespace aux::<unnamed>
 
    void pub::stk_limit (long long size) noexcept {
@@ -53,77 +73,235 @@ namespace aux { namespace {
       auto saved_size = stk_res; (stk_lim -= stk_res) += size, stk_res = size; return saved_size;
    }
    long long pub::heap_reserve(long long size) noexcept {
+      MNL_IF_WITH_MT(_heap_flush();) // the credit was taken under the previous reservation
       auto saved_size = heap_res; heap_res = size; return saved_size;
    }
+   long long pub::heap_slack(long long size) noexcept {
+   # if MNL_WITH_MULTITHREADING
+      return __atomic_exchange_n(&heap_slk, size, __ATOMIC_RELAXED);
+   # else
+      return (void)size, 0;
+   # endif
+   }
    void aux::err_stk_overflow() {
       if (stk_res) stk_lim -= stk_res, stk_res = 0, throw stack_overflow{};
       fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Stack overflow (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
    }
 
 namespace aux { namespace {
-   MNL_INLINE inline void *_new(size_t size) {
-      if (MNL_UNLIKELY(!size)) size = 1;
-      auto ptr = ::malloc(size); // Note: the VM pages are still not committed here
-      if (MNL_UNLIKELY(!ptr)) {
-         if (size <= 1ll << 47 && (long long) MNL_IF_WITH_MT(__atomic_load_n(&heap_use, __ATOMIC_RELAXED))
-            MNL_IF_WITHOUT_MT(heap_use) + (long long)size + (long long)sizeof(size_t) <= heap_lim - heap_res)
-            perror("MANOOL: FATAL ERROR: Cannot malloc"), fflush(stderr), _Exit(EXIT_FAILURE);
-         if (heap_res) heap_res = 0, throw heap_exhausted{};
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
-      }
+   // Small objects (up to slab_max bytes) are carved out of per-thread slabs, one free list per size class; slabs are charged to heap_use as
+   // a whole on acquisition, and once a free list grows past its trim threshold, the slabs all of whose blocks are on it get returned to ::malloc
+   // and uncharged (see _slab_trim). Every block is preceded by a size_t header holding its size class (or, for large objects, which go straight
+   // to ::malloc, the amount charged to heap_use), so the payload stays aligned to 16 bytes, like with ::malloc, and no ::malloc_usable_size is
+   // needed on deallocation. Slabs are aligned to slab_size, so the slab of a block is found by masking its address.
+   constexpr size_t slab_size = 32 * 1024, slab_max = 248, slab_cls_cnt = (slab_max + sizeof(size_t) + 15) / 16 + 1;
+   constexpr size_t slab_keep = 4; // slabs worth of free blocks per size class that never trigger trimming
+
+   struct slab_pool { void *free; char *next, *end; size_t free_cnt, trim_at; }; // free_cnt: length of the free list
+   MNL_IF_WITH_MT(thread_local) slab_pool slab_pools[slab_cls_cnt];
+
+   MNL_INLINE inline size_t slab_cls(size_t size) noexcept { return (size + sizeof(size_t) + 15) / 16; } // precond: size <= slab_max
+   MNL_INLINE inline size_t slab_off(size_t cls) noexcept { return cls % 16 * 256 + sizeof(size_t); } // staggered to avoid 4K aliasing among classes
+   MNL_INLINE inline size_t slab_blk_cnt(size_t cls) noexcept { return (slab_size - slab_off(cls)) / (cls * 16); }
+
+   // Allocation and deallocation counts by size class ([0] is for large blocks), for heap_stats
+   struct heap_counters { unsigned long long alloc[slab_cls_cnt], free[slab_cls_cnt]; MNL_IF_WITH_MT(heap_counters *prev, *next;) };
+   MNL_IF_WITH_MT(thread_local) heap_counters heap_cnt;
+   /*atomic*/ size_t heap_peak;
+
+   MNL_INLINE inline void _count(unsigned long long &cnt) noexcept { // concurrent readers (in heap_stats) see either value
+      MNL_IF_WITH_MT(__atomic_store_n(&cnt, cnt + 1, __ATOMIC_RELAXED))MNL_IF_WITHOUT_MT(++cnt);
+   }
+   MNL_INLINE inline void _peak(size_t _heap_use) noexcept {
    # if MNL_WITH_MULTITHREADING
-      size = ::malloc_usable_size(ptr) + sizeof(size_t);
-      auto _heap_use = __atomic_load_n(&heap_use, __ATOMIC_RELAXED);
-      do if (MNL_UNLIKELY((long long)(_heap_use + size) > heap_lim - heap_res)) {
-         ::free(ptr);
-         if (heap_res) heap_res = 0, throw heap_exhausted{};
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
-      } while (MNL_UNLIKELY(!__atomic_compare_exchange_n(&heap_use, &_heap_use, _heap_use + size, {}, __ATOMIC_RELAXED, __ATOMIC_RELAXED)));
+      auto _heap_peak = __atomic_load_n(&heap_peak, __ATOMIC_RELAXED);
+      while (_heap_use > _heap_peak && !__atomic_compare_exchange_n(&heap_peak, &_heap_peak, _heap_use, {}, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
    # else
-      if (MNL_UNLIKELY((long long)(heap_use + (size = ::malloc_usable_size(ptr) + sizeof(size_t))) > heap_lim - heap_res)) {
-         ::free(ptr);
-         if (heap_res) heap_res = 0, throw heap_exhausted{};
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
+      if (_heap_use > heap_peak) heap_peak = _heap_use;
+   # endif // # if MNL_WITH_MULTITHREADING
+   }
+
+# if MNL_WITH_MULTITHREADING
+   // Blocks left on free lists of terminated threads are handed over to other threads through the depot, and their heap credit is given back;
+   // heap_cnt of running threads are linked into a ring, whose head accumulates the counters of terminated threads
+   slab_pool slab_depot[slab_cls_cnt]; heap_counters heap_cnt_ring{{}, {}, &heap_cnt_ring, &heap_cnt_ring}; std::mutex thread_mutex;
+   thread_local struct thread_exit { bool armed; ~thread_exit() {
+      _heap_flush();
+      std::lock_guard<std::mutex> _lg(thread_mutex);
+      for (size_t cls = 0; cls < slab_cls_cnt; ++cls)
+         heap_cnt_ring.alloc[cls] += heap_cnt.alloc[cls], heap_cnt_ring.free[cls] += heap_cnt.free[cls];
+      heap_cnt.prev->next = heap_cnt.next, heap_cnt.next->prev = heap_cnt.prev;
+      for (size_t cls = 1; cls < slab_cls_cnt; ++cls) {
+         auto &pool = slab_pools[cls];
+         for (; pool.next != pool.end; pool.next += cls * 16) // carve out the rest of the current slab
+            *reinterpret_cast<size_t *>(pool.next) = cls, *reinterpret_cast<void **>(pool.next + sizeof(size_t)) = pool.free,
+            pool.free = pool.next + sizeof(size_t);
+         if (!pool.free) continue;
+         auto tail = pool.free; size_t cnt = 1; while (*static_cast<void **>(tail)) tail = *static_cast<void **>(tail), ++cnt;
+         *static_cast<void **>(tail) = slab_depot[cls].free, __atomic_store_n(&slab_depot[cls].free, pool.free, __ATOMIC_RELAXED), pool.free = {};
+         slab_depot[cls].free_cnt += cnt, pool.free_cnt = 0;
       }
-      heap_use += size;
+   }} _thread_exit;
+   MNL_NOINLINE void _thread_enter() noexcept { // registers the thread-exit hook
+      std::lock_guard<std::mutex> _lg(thread_mutex);
+      heap_cnt.prev = &heap_cnt_ring, heap_cnt.next = heap_cnt_ring.next, heap_cnt_ring.next = heap_cnt_ring.next->prev = &heap_cnt;
+      _thread_exit.armed = true;
+   }
+
+   MNL_NOINLINE bool _charge_refill(size_t size) noexcept {
+      auto need = (long long)size - heap_crd, slk = __atomic_load_n(&heap_slk, __ATOMIC_RELAXED);
+      auto _heap_use = __atomic_load_n(&heap_use, __ATOMIC_RELAXED);
+      for (;;) {
+         auto take = (long long)_heap_use + need + slk <= heap_lim - heap_res ? need + slk : need; // fall back to the exact amount near the limit
+         if (MNL_UNLIKELY((long long)_heap_use + take > heap_lim - heap_res)) return false;
+         if (MNL_LIKELY(__atomic_compare_exchange_n(&heap_use, &_heap_use, _heap_use + take, {}, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+            return heap_crd += take - (long long)size, _peak(_heap_use + take), true;
+      }
+   }
+# endif // # if MNL_WITH_MULTITHREADING
+   MNL_INLINE inline bool _charge(size_t size) noexcept {
+   # if MNL_WITH_MULTITHREADING
+      if (MNL_LIKELY((long long)size <= heap_crd)) return heap_crd -= size, true;
+      if (MNL_UNLIKELY(!_thread_exit.armed)) _thread_enter(); // to give the credit back eventually
+      return _charge_refill(size);
+   # else
+      if (MNL_UNLIKELY((long long)(heap_use + size) > heap_lim - heap_res)) return false;
+      _peak(heap_use += size);
+      return true;
    # endif // # if MNL_WITH_MULTITHREADING
-      return ptr;
    }
-   MNL_INLINE inline void *_new(size_t size, const std::nothrow_t &) noexcept {
-      if (MNL_UNLIKELY(!size)) size = 1;
-      auto ptr = ::malloc(size); // Note: the VM pages are still not committed here
+   MNL_INLINE inline void _uncharge(size_t size) noexcept {
+   # if MNL_WITH_MULTITHREADING
+      auto slk = __atomic_load_n(&heap_slk, __ATOMIC_RELAXED);
+      if (MNL_UNLIKELY((heap_crd += size) > 2 * slk)) __atomic_sub_fetch(&heap_use, heap_crd - slk, __ATOMIC_RELAXED), heap_crd = slk;
+   # else
+      heap_use -= size;
+   # endif // # if MNL_WITH_MULTITHREADING
+   }
+
+   MNL_NOINLINE void *_exhausted() noexcept {
+      if (heap_res) return heap_res = 0, nullptr;
+      fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
+   }
+   MNL_INLINE inline void *_malloc(size_t size, size_t &charge, size_t align = 0) noexcept { // returns nullptr on heap exhaustion (if a reservation is in effect)
+      auto ptr = MNL_LIKELY(size <= 1ll << 47) ? align ? ::aligned_alloc(align, size) : ::malloc(size) : nullptr; // Note: the VM pages are still not committed here
       if (MNL_UNLIKELY(!ptr)) {
          if (size <= 1ll << 47 && (long long) MNL_IF_WITH_MT(__atomic_load_n(&heap_use, __ATOMIC_RELAXED))
             MNL_IF_WITHOUT_MT(heap_use) + (long long)size + (long long)sizeof(size_t) <= heap_lim - heap_res)
             perror("MANOOL: FATAL ERROR: Cannot malloc"), fflush(stderr), _Exit(EXIT_FAILURE);
-         if (heap_res) return heap_res = 0, nullptr;
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
+         return _exhausted();
       }
+      if (MNL_UNLIKELY(!_charge(charge = ::malloc_usable_size(ptr) + sizeof(size_t)))) return ::free(ptr), _exhausted();
+      return ptr;
+   }
+
+   MNL_NOINLINE void *_slab_refill(size_t cls) noexcept {
+      auto &pool = slab_pools[cls];
    # if MNL_WITH_MULTITHREADING
-      size = ::malloc_usable_size(ptr) + sizeof(size_t);
-      auto _heap_use = __atomic_load_n(&heap_use, __ATOMIC_RELAXED);
-      do if (MNL_UNLIKELY((long long)(_heap_use + size) > heap_lim - heap_res)) {
-         ::free(ptr);
-         if (heap_res) return heap_res = 0, nullptr;
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
-      } while (MNL_UNLIKELY(!__atomic_compare_exchange_n(&heap_use, &_heap_use, _heap_use + size, {}, __ATOMIC_RELAXED, __ATOMIC_RELAXED)));
-   # else
-      if (MNL_UNLIKELY((long long)(heap_use + (size = ::malloc_usable_size(ptr) + sizeof(size_t))) > heap_lim - heap_res)) {
-         ::free(ptr);
-         if (heap_res) return heap_res = 0, nullptr;
-         fprintf(stderr, "MANOOL: FATAL ERROR: %s\n", "Heap exhausted (and no reservation is in effect)"), fflush(stderr), _Exit(EXIT_FAILURE);
+      if (MNL_UNLIKELY(!_thread_exit.armed)) _thread_enter();
+      if (__atomic_load_n(&slab_depot[cls].free, __ATOMIC_RELAXED)) {
+         std::lock_guard<std::mutex> _lg(thread_mutex);
+         pool.free = slab_depot[cls].free, slab_depot[cls].free = {}, pool.free_cnt = slab_depot[cls].free_cnt, slab_depot[cls].free_cnt = 0;
       }
-      heap_use += size;
+      if (pool.free) { auto ptr = pool.free; pool.free = *static_cast<void **>(ptr), --pool.free_cnt; return ptr; }
    # endif // # if MNL_WITH_MULTITHREADING
+      size_t charge; auto slab = static_cast<char *>(_malloc(slab_size, charge, slab_size)); if (MNL_UNLIKELY(!slab)) return nullptr;
+      pool.next = slab + slab_off(cls), pool.end = pool.next + slab_blk_cnt(cls) * (cls * 16);
+      *reinterpret_cast<size_t *>(pool.next) = cls; auto ptr = pool.next + sizeof(size_t); pool.next += cls * 16;
+      return ptr;
+   }
+   // Return to ::malloc the slabs all of whose blocks are on the free list (in multithreaded builds, no block of such a slab can be anywhere else, and the
+   // slab some thread is carving out has blocks on no free list), then wait until the list doubles (amortized O(log n) per deallocation)
+   MNL_NOINLINE void _slab_trim(size_t cls) noexcept {
+      auto &pool = slab_pools[cls]; auto blk_cnt = slab_blk_cnt(cls);
+      if (auto slabs = static_cast<uintptr_t *>(::malloc(pool.free_cnt * sizeof(uintptr_t)))) { // scratch space (not accounted for)
+         size_t cnt = 0;
+         for (auto ptr = pool.free; ptr; ptr = *static_cast<void **>(ptr)) slabs[cnt++] = reinterpret_cast<uintptr_t>(ptr) & ~(slab_size - 1);
+         sort(slabs, slabs + cnt);
+         size_t free_cnt = 0; // wholly free slabs, compacted in ascending order at the beginning of slabs
+         for (size_t sn = 0, end; sn < cnt; sn = end) {
+            for (end = sn + 1; end < cnt && slabs[end] == slabs[sn]; ++end);
+            if (end - sn == blk_cnt) slabs[free_cnt++] = slabs[sn];
+         }
+         if (free_cnt) {
+            auto link = &pool.free;
+            for (auto ptr = pool.free; ptr; ptr = *static_cast<void **>(ptr))
+               if (!binary_search(slabs, slabs + free_cnt, reinterpret_cast<uintptr_t>(ptr) & ~(slab_size - 1))) *link = ptr, link = static_cast<void **>(ptr);
+            *link = {}, pool.free_cnt -= free_cnt * blk_cnt;
+            for (size_t sn = 0; sn < free_cnt; ++sn) { auto slab = reinterpret_cast<void *>(slabs[sn]);
+               _uncharge(::malloc_usable_size(slab) + sizeof(size_t)), ::free(slab); } // as charged in _malloc
+         }
+         ::free(slabs);
+      }
+      pool.trim_at = max(slab_keep * blk_cnt, 2 * pool.free_cnt);
+   }
+   MNL_INLINE inline void _slab_put(size_t cls, void *ptr) noexcept {
+      auto &pool = slab_pools[cls]; *static_cast<void **>(ptr) = pool.free, pool.free = ptr;
+      if (MNL_UNLIKELY(++pool.free_cnt > pool.trim_at)) _slab_trim(cls);
+   }
+
+   MNL_INLINE inline void *_new(size_t size, const std::nothrow_t &) noexcept {
+      if (MNL_LIKELY(size <= slab_max)) {
+         auto cls = slab_cls(size); auto &pool = slab_pools[cls]; void *ptr;
+         if (MNL_LIKELY(pool.free))
+            ptr = pool.free, pool.free = *static_cast<void **>(ptr), --pool.free_cnt;
+         else
+         if (MNL_LIKELY(pool.next != pool.end))
+            *reinterpret_cast<size_t *>(pool.next) = cls, ptr = pool.next + sizeof(size_t), pool.next += cls * 16;
+         else
+         if (MNL_UNLIKELY(!(ptr = _slab_refill(cls))))
+            return nullptr;
+         return _count(heap_cnt.alloc[cls]), ptr;
+      }
+      size_t charge; auto ptr = static_cast<size_t *>(_malloc(size + 2 * sizeof(size_t), charge)); if (MNL_UNLIKELY(!ptr)) return nullptr;
+      ptr[1] = charge; return _count(heap_cnt.alloc[0]), ptr + 2; // charge >= slab_cls_cnt
+   }
+   MNL_INLINE inline void *_new(size_t size) {
+      auto ptr = _new(size, std::nothrow); if (MNL_UNLIKELY(!ptr)) throw heap_exhausted{};
       return ptr;
    }
    MNL_INLINE inline void _delete(void *ptr) noexcept {
       if (MNL_UNLIKELY(!ptr)) return;
-      auto size = ::malloc_usable_size(ptr) + sizeof(size_t);
-      ::free(ptr), MNL_IF_WITH_MT(__atomic_sub_fetch(&heap_use, size, __ATOMIC_RELAXED))MNL_IF_WITHOUT_MT(heap_use -= size);
+      auto cls = static_cast<size_t *>(ptr)[-1];
+      if (MNL_LIKELY(cls < slab_cls_cnt))
+         { _slab_put(cls, ptr), _count(heap_cnt.free[cls]); return; }
+      _uncharge(cls), ::free(static_cast<size_t *>(ptr) - 2), _count(heap_cnt.free[0]);
+   }
+   MNL_INLINE inline void _delete(void *ptr, size_t size) noexcept { // sized deallocation - no header lookup for small objects
+      if (MNL_UNLIKELY(!ptr)) return;
+      if (MNL_LIKELY(size <= slab_max)) {
+         auto cls = slab_cls(size); _slab_put(cls, ptr), _count(heap_cnt.free[cls]); return;
+      }
+      _delete(ptr);
    }
 }} // namespace aux::<unnamed>
 
+   heap_statistics pub::heap_stats() noexcept {
+      static_assert(sizeof heap_statistics{}.size_class / sizeof *heap_statistics{}.size_class == slab_cls_cnt, "size classes mismatch");
+      heap_counters sum{};
+   # if MNL_WITH_MULTITHREADING
+      {  std::lock_guard<std::mutex> _lg(thread_mutex);
+         for (auto it = &heap_cnt_ring;;) {
+            for (size_t cls = 0; cls < slab_cls_cnt; ++cls)
+               sum.alloc[cls] += __atomic_load_n(&it->alloc[cls], __ATOMIC_RELAXED), sum.free[cls] += __atomic_load_n(&it->free[cls], __ATOMIC_RELAXED);
+            if ((it = it->next) == &heap_cnt_ring) break;
+         }
+      }
+      if (!_thread_exit.armed) // not yet in the ring
+         for (size_t cls = 0; cls < slab_cls_cnt; ++cls) sum.alloc[cls] += heap_cnt.alloc[cls], sum.free[cls] += heap_cnt.free[cls];
+   # else
+      sum = heap_cnt;
+   # endif // # if MNL_WITH_MULTITHREADING
+      heap_statistics res{};
+      res.current = MNL_IF_WITH_MT(__atomic_load_n(&heap_use, __ATOMIC_RELAXED))MNL_IF_WITHOUT_MT(heap_use);
+      res.peak    = MNL_IF_WITH_MT(__atomic_load_n(&heap_peak, __ATOMIC_RELAXED))MNL_IF_WITHOUT_MT(heap_peak);
+      for (size_t cls = 1; cls < slab_cls_cnt; ++cls)
+         res.size_class[cls - 1] = {(long long)(cls * 16 - sizeof(size_t)), (long long)sum.alloc[cls], (long long)sum.free[cls]};
+      res.size_class[slab_cls_cnt - 1] = {(1ll << 47) - 1, (long long)sum.alloc[0], (long long)sum.free[0]};
+      for (auto &&el: res.size_class) res.alloc_count += el.alloc_count, res.free_count += el.free_count;
+      return res;
+   }
+
    const char *stack_overflow::what() const noexcept { return "mnl::stack_overflow"; }
    const char *heap_exhausted::what() const noexcept { return "mnl::heap_exhausted"; }
 
@@ -134,8 +312,10 @@ void *operator new(std::size_t size) { return mnl::_new(size); }
 void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return mnl::_new(size, std::nothrow); }
 void operator delete(void *ptr) noexcept { mnl::_delete(ptr); }
 void operator delete(void *ptr, const std::nothrow_t &) noexcept { mnl::_delete(ptr); }
+void operator delete(void *ptr, std::size_t size) noexcept { mnl::_delete(ptr, size); }
 
 void *operator new[](std::size_t size) { return mnl::_new(size); }
 void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return mnl::_new(size, std::nothrow); }
 void operator delete[](void *ptr) noexcept { mnl::_delete(ptr); }
 void operator delete[](void *ptr, const std::nothrow_t &) noexcept { mnl::_delete(ptr); }
+void operator delete[](void *ptr, std::size_t size) noexcept { mnl::_delete(ptr, size); }
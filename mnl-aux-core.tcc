@@ -67,28 +67,30 @@ namespace aux {
    namespace aux { namespace pub { class val; } }
    template<typename> class box;
    namespace aux { template<int> struct _record; }
+   namespace aux { class apply_cache; }
    namespace aux { namespace pub { template<bool> struct range; } }
+   namespace aux { namespace pub { struct string_slice; } }
 
    namespace aux { namespace pub { struct loc/*ation in source code*/ { shared_ptr<const string> origin; pair<int, int> _start, _final; }; } }
    namespace aux { template<size_t Argc> using args = array<val, Argc>; } // assume any g++-like compiler relaxes ISO/IEC 14882:2011 S8.5.1 P11 as in C++14
 
 // class sym ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 namespace aux { namespace pub {
-   class sym/*bol*/ {
+   class MNL_PACK MNL_ALIGN(2) sym/*bol*/ { // 2-byte alignment lets the 32-bit ID share val::rep with its 16-bit tag
    public: // Standard operations
       MNL_INLINE sym() noexcept: sym{decltype(rep){}} {}
       MNL_INLINE sym(const sym &rhs) noexcept: sym{rhs.rep} {}
       MNL_INLINE ~sym() { release(); }
       MNL_INLINE sym &operator=(const sym &rhs) noexcept { rhs.addref(), release(), rep = rhs.rep; return *this; }
       MNL_INLINE sym &operator=(sym &&rhs) noexcept { swap(rhs); return *this; }
-      MNL_INLINE void swap(sym &rhs) noexcept { using std::swap; swap(rep, rhs.rep); }
+      MNL_INLINE void swap(sym &rhs) noexcept { auto tmp = rep; rep = rhs.rep, rhs.rep = tmp; } // (packed member)
       MNL_INLINE friend bool operator==(const sym &lhs, const sym &rhs) noexcept { return lhs.rep == rhs; }
       MNL_INLINE friend bool operator< (const sym &lhs, const sym &rhs) noexcept { auto mask = MNL_AUX_RAND(unsigned); return (lhs ^ mask) < (rhs ^ mask); }
       MNL_INLINE explicit operator bool() const noexcept { return rep; }
    public: // Construction and extraction via conversion
       sym(string), sym(const char *);
       explicit sym(decltype(nullptr));
-      MNL_INLINE explicit operator const string &() const noexcept { return inverse[rep]->first; } // no sync required
+      MNL_INLINE explicit operator const string &() const noexcept { return *inverse(rep); } // no sync required
       MNL_INLINE explicit operator const char *() const noexcept { return ((const string &)*this).c_str(); }
    public: // Functional application
       static constexpr int max_argc = 999;
@@ -100,13 +102,13 @@ namespace aux { namespace pub {
       val operator()(const loc &, const val &, val * = {}) const, operator()(const loc &, val &&, val * = {}) const;
       template<size_t Argc> val operator()(const loc &, args<Argc> &&, val * = {}) const;
    private: // Concrete representation
-      enum rep: unsigned short;
+      enum rep: unsigned;
       enum rep rep; // "enum" is required as per ISO/IEC 14882:2011 S3.3.7 P1, although some C++ compilers do not issue any diagnostic message
-      static map<string, const decltype(rep)> dict;
-      static decltype(dict)::const_iterator inverse[];
-      static vector<decltype(rep)> pool;
-      MNL_IF_WITH_MT(static std::mutex mutex;)
-      static /*atomic*/ long rc[];
+      class dictionary; static dictionary dict;
+      static constexpr int seg_bits = 16; // per-ID data lives in segments, which are allocated on demand and never relocated
+      static struct segment { const string *inverse[1 << seg_bits]; unsigned hash[1 << seg_bits]; /*atomic*/ long rc[1 << seg_bits]; } seg0, *segments[];
+      MNL_INLINE static const string *&inverse(decltype(rep) rep) noexcept { return segments[rep >> seg_bits]->inverse[rep & (1 << seg_bits) - 1]; }
+      MNL_INLINE static long &rc(decltype(rep) rep) noexcept { return segments[rep >> seg_bits]->rc[rep & (1 << seg_bits) - 1]; }
       MNL_INLINE explicit sym(decltype(rep) rep) noexcept: rep(rep) { addref(); }
       MNL_INLINE operator decltype(rep)() const noexcept { return rep; }
    private: // Implementation helpers
@@ -115,15 +117,31 @@ namespace aux { namespace pub {
       static void free(decltype(rep)) noexcept;
    private:
       MNL_INLINE static void addref(decltype(rep) rep) noexcept
-         { MNL_IF_WITHOUT_MT(++rc[rep]) MNL_IF_WITH_MT(__atomic_add_fetch(&rc[rep], 1, __ATOMIC_RELAXED)); }
+         { MNL_IF_WITHOUT_MT(++rc(rep)) MNL_IF_WITH_MT(__atomic_add_fetch(&rc(rep), 1, __ATOMIC_RELAXED)); }
       MNL_INLINE static void release(decltype(rep) rep) noexcept
-         { if (MNL_UNLIKELY(! MNL_IF_WITHOUT_MT(--rc[rep]) MNL_IF_WITH_MT(__atomic_sub_fetch(&rc[rep], 1, __ATOMIC_RELAXED)) )) free(rep); }
+         { if (MNL_UNLIKELY(! MNL_IF_WITHOUT_MT(--rc(rep)) MNL_IF_WITH_MT(__atomic_sub_fetch(&rc(rep), 1, __ATOMIC_RELAXED)) )) free(rep); }
    public: // Related stuff
       template<typename = class code> class tab/*le*/; // do not: move "= class code" to the definition below (compiler bug)
       friend val;
-      friend box<string>; friend box<vector<val>>; // direct access to "enum rep" members required, for performance reasons
-      template<int> friend struct aux::_record;    // ditto
-      friend range<false>; friend range<true>;     // ditto
+      friend box<string>; friend box<string_slice>; friend box<vector<val>>; // direct access to "enum rep" members required, for performance reasons
+      template<int> friend struct aux::_record;                              // ditto
+      friend range<false>; friend range<true>;                               // ditto
+   };
+   class sym::dictionary { // interning table: open addressing, with striped locking in MT builds
+   public:
+      dictionary(initializer_list<pair<const char *, decltype(rep)>>); // predefined symbols
+      decltype(rep) intern(string &&);
+      decltype(rep) make_unique(); // uninterned symbol
+      void free(decltype(rep)) noexcept;
+   private:
+      static constexpr int stripe_count = MNL_IF_WITHOUT_MT(1) MNL_IF_WITH_MT(64); // power of 2
+      struct stripe { vector<long> slots; int used = 0; MNL_IF_WITH_MT(std::mutex mutex;) } stripes[stripe_count];
+      vector<decltype(rep)> pool; long count = 0; // ID allocation (pool is a min-heap)
+      MNL_IF_WITH_MT(std::mutex mutex;)
+   private:
+      decltype(rep) alloc();
+      void insert(stripe &, decltype(rep));
+      MNL_INLINE static unsigned &hash(decltype(rep) rep) noexcept { return segments[rep >> seg_bits]->hash[rep & (1 << seg_bits) - 1]; }
    };
    MNL_INLINE inline void swap(sym &lhs, sym &rhs) noexcept { lhs.swap(rhs); }
    bool operator==(const sym &, const sym &) noexcept, operator<(const sym &, const sym &) noexcept;
@@ -181,6 +199,51 @@ namespace aux { MNL_NOINLINE inline sym::tab<signed char> disp(initializer_list<
    sym::tab<signed char> res; int val = 0; for (auto &&key: il) res.update(key, ++val); return res;
 }}
 
+// Biased Reference Counting //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+# if MNL_WITH_MULTITHREADING
+namespace aux {
+   /* Biased reference counting (J. Choi, T. Shull, J. Torrellas, PACT'18): the thread that creates an object (its owner) maintains its share
+      of the reference count with plain loads and stores, and all other threads update an atomic shared count; the latter may become negative,
+      in which case the object is queued to its owner for an explicit merge of both counts; the counts also get merged when the owner drops
+      its share to zero.  */
+   struct rc_owner { // per-thread (intentionally leaked on thread exit since objects may still refer to it)
+      /*atomic*/ bool quiet; // no queued objects (false for the initial placeholder, to route the first object creation through rc_enter)
+      bool alive; std::mutex mutex; vector<class rc_biased *> queue;
+   };
+   extern thread_local rc_owner *rc_self; // initially points to the placeholder
+   class rc_biased {
+   protected:
+      MNL_INLINE rc_biased(): owner(MNL_LIKELY(__atomic_load_n(&rc_self->quiet, __ATOMIC_RELAXED)) ? rc_self : rc_enter()) {}
+      virtual ~rc_biased() = default;
+   public:
+      MNL_INLINE long rc() const noexcept // exact whenever the caller holds the only reference
+         { return __atomic_load_n(&biased, __ATOMIC_RELAXED) + (__atomic_load_n(&shared, __ATOMIC_RELAXED) >> 2); }
+      MNL_INLINE void addref() noexcept {
+         if (MNL_LIKELY(__atomic_load_n(&owner, __ATOMIC_RELAXED) == rc_self))
+            __atomic_store_n(&biased, __atomic_load_n(&biased, __ATOMIC_RELAXED) + 1, __ATOMIC_RELAXED);
+         else
+            __atomic_add_fetch(&shared, 1 << 2, __ATOMIC_RELAXED);
+      }
+      MNL_INLINE bool release() noexcept { // true => delete
+         if (MNL_LIKELY(__atomic_load_n(&owner, __ATOMIC_RELAXED) == rc_self)) {
+            auto res = __atomic_load_n(&biased, __ATOMIC_RELAXED) - 1; __atomic_store_n(&biased, res, __ATOMIC_RELAXED);
+            return MNL_UNLIKELY(!res) && merge_implicit();
+         }
+         auto res = __atomic_sub_fetch(&shared, 1 << 2, __ATOMIC_ACQ_REL);
+         return MNL_UNLIKELY(res < 1 << 2) && (res == merged || MNL_UNLIKELY(res < 0) && enqueue(res));
+      }
+   private:
+      rc_owner *owner; // nullptr after merge
+      unsigned biased = 1;
+      /*atomic*/ int shared = 0; // count << 2 | queued | merged
+      static constexpr int merged = 1, queued = 2;
+      static rc_owner *rc_enter(); // registers the thread or performs pending explicit merges
+      bool merge_implicit() noexcept, merge_explicit() noexcept, enqueue(int) noexcept;
+      friend struct rc_exit;
+   };
+} // namespace aux
+# endif // # if MNL_WITH_MULTITHREADING
+
 // class val ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template<typename> class box;
@@ -208,6 +271,7 @@ namespace aux { namespace pub {
       MNL_INLINE val(unsigned dat) noexcept: rep{0x7FFDu, dat} {}
       MNL_INLINE val(char dat) noexcept:     val((unsigned)(unsigned char)dat) {}
       template<typename Dat> val(Dat dat): rep{0x7FF8u, (void *)(root *)new box<Dat>{(move)(dat)}} {}
+      val(string); // strings of up to short_string_max bytes are kept unboxed
       val(const char *);
       MNL_INLINE val(char *dat): val((const char *)dat) {}
    public: // Extraction
@@ -302,6 +366,14 @@ namespace aux { namespace pub {
       bool operator==(decltype(nullptr)) const noexcept, operator==(const sym &) const noexcept;
       MNL_INLINE bool operator!=(decltype(nullptr)) const noexcept { return !(*this == nullptr); }
       MNL_INLINE bool operator!=(const sym &rhs) const noexcept { return !(*this == rhs); }
+   public: // Convenience -- Strings (an unboxed short string, tag 0xFFF8u, a box<string>, and a box<string_slice> are representations of the same MANOOL type)
+      static constexpr int short_string_max = 5;
+      bool is_string() const noexcept;
+      bool box_string(); // boxes a short string (or materializes a slice) in place so that test<string>() and cast<const string &>() apply; returns is_string()
+      bool string_data(const char *&, size_t &) const noexcept; // (data, size) of a String in any representation, without boxing or copying; returns is_string()
+   private:
+      struct short_string { char dat[short_string_max]; unsigned char size; }; // zero-padded, so that equal strings have equal representations
+      val _apply_short_string(int, val [], val *) &&;
    public: // Convenience -- Working with ASTs
       val(vector<ast>, loc);
       bool is_list() const noexcept;
@@ -330,6 +402,7 @@ namespace aux { namespace pub {
       friend val _eq(val &&, val &&), _ne(val &&, val &&), _lt(val &&, val &&), _le(val &&, val &&), _gt(val &&, val &&), _ge(val &&, val &&);
       friend val _add(val &&, val &&), _sub(val &&, val &&), _mul(val &&, val &&), _neg(val &&), _abs(val &&), _xor(val &&, val &&), _not(val &&);
       friend class proc_Min; friend class proc_Max;
+      friend class aux::apply_cache;
    };
    MNL_INLINE inline void swap(val &lhs, val &rhs) noexcept { lhs.swap(rhs); }
    // defined in friend declarations above:
@@ -394,7 +467,7 @@ namespace aux { namespace pub {
       { return _sym; }
 
 // class Template box //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-   class val::root {
+   class val::root MNL_IF_WITH_MT(: aux::rc_biased) {
    protected:
       root() = default;
       virtual ~root() = default;
@@ -402,13 +475,15 @@ namespace aux { namespace pub {
       root(const root &) = delete;
       root &operator=(const root &) = delete;
    protected:
-      long rc() const { return MNL_IF_WITHOUT_MT(_rc) MNL_IF_WITH_MT(__atomic_load_n(&_rc, __ATOMIC_RELAXED)); }
+      long rc() const { return MNL_IF_WITHOUT_MT(_rc) MNL_IF_WITH_MT(rc_biased::rc()); }
    private:
-      /*atomic*/ long _rc = 1;
+      MNL_IF_WITHOUT_MT(long _rc = 1;)
       virtual val invoke(val &&, const sym &, int, val [], val * = {}) = 0;
    public:
       friend sym;
       friend val;
+      friend box<string_slice>; // falls back to box<string>
+      friend class aux::apply_cache;
       friend val _eq(val &&, val &&), _ne(val &&, val &&), _lt(val &&, val &&), _le(val &&, val &&), _gt(val &&, val &&), _ge(val &&, val &&);
       friend val _add(val &&, val &&), _sub(val &&, val &&), _mul(val &&, val &&), _neg(val &&), _abs(val &&), _xor(val &&, val &&), _not(val &&);
    };
@@ -429,12 +504,44 @@ namespace aux { namespace pub {
    template<> class box<unsigned>;          // ditto
    template<> class box<char>;              // ditto
 
+namespace aux { namespace pub {
+   struct string_slice { // zero-copy substring sharing the buffer of a box<string> (never mutated while shared), materialized by val::box_string
+      val base; long lo, size;
+      bool growable; // base is private to slices, which may append to it in place (see String + in core-ops.cc)
+      const char *data() const noexcept;
+   };
+}} // namespace aux::pub
+
    template<> val box<std::string>::invoke(val &&, const sym &, int, val [], val *);
+   template<> val box<string_slice>::invoke(val &&, const sym &, int, val [], val *);
    template<> val box<std::pair<std::vector<ast>, loc>>::invoke(val &&, const sym &, int, val [], val *);
    template<> val box<std::vector<val>>::invoke(val &&, const sym &, int, val [], val *);
    template<> inline box<std::vector<val>>::~box() { while (!dat.empty()) dat.pop_back(); }
 
-   MNL_NOINLINE inline val::val(const char *dat): val((string)dat) {} // postponed definition because the complete type box<std::string> was needed
+   // postponed definitions because the complete type box<std::string> was needed:
+   MNL_INLINE inline val::val(string dat) {
+      if (MNL_LIKELY(dat.size() > short_string_max)) { rep = decltype(rep){0x7FF8u, (void *)(root *)new box<string>{move(dat)}}; return; }
+      short_string res{}; memcpy(res.dat, dat.data(), res.size = dat.size()); rep = decltype(rep){0xFFF8u, res};
+   }
+   MNL_NOINLINE inline val::val(const char *dat): val((string)dat) {}
+   MNL_INLINE inline bool val::is_string() const noexcept
+      { return rep.tag() == 0xFFF8u || test<string>() || test<string_slice>(); }
+   MNL_INLINE inline bool val::box_string() {
+      if (MNL_UNLIKELY(rep.tag() == 0xFFF8u))
+         rep = decltype(rep){0x7FF8u, (void *)(root *)new box<string>{string(rep.dat<short_string>().dat, rep.dat<short_string>().size)}};
+      else if (MNL_UNLIKELY(test<string_slice>()))
+         *this = val{decltype(rep){0x7FF8u, (void *)(root *)new box<string>{string(cast<const string_slice &>().data(), cast<const string_slice &>().size)}}};
+      return test<string>();
+   }
+   MNL_INLINE inline const char *string_slice::data() const noexcept
+      { return cast<const string &>(base).data() + lo; }
+   MNL_INLINE inline bool val::string_data(const char *&dat, size_t &size) const noexcept {
+      if (MNL_LIKELY(rep.tag() == 0xFFF8u)) // in place (see rep::dat), valid while *this is unchanged
+         return dat = reinterpret_cast<const char *>(&rep), size = reinterpret_cast<const unsigned char *>(&rep)[offsetof(short_string, size)], true;
+      if (MNL_LIKELY(test<string>())) return dat = cast<const string &>().data(), size = cast<const string &>().size(), true;
+      if (MNL_UNLIKELY(test<string_slice>())) return dat = cast<const string_slice &>().data(), size = cast<const string_slice &>().size, true;
+      return false;
+   }
    // postponed definitions because the complete types box<std::vector<ast>>, box<std::pair<std::vector<ast>, loc>> were needed:
    MNL_INLINE inline ast::val(vector<ast> first, loc second)
       : ast(make_pair(move(first), move(second))) {}
@@ -475,30 +582,30 @@ namespace aux { namespace pub {
       switch (rep.tag()) {
       case 0x7FFBu: rep.dat<const sym &>().addref(); return;
       case 0x7FF8u: MNL_IF_WITHOUT_MT(++static_cast<root *>(rep.dat<void *>())->_rc)
-         MNL_IF_WITH_MT(__atomic_add_fetch(&static_cast<root *>(rep.dat<void *>())->_rc, 1, __ATOMIC_RELAXED));
+         MNL_IF_WITH_MT(static_cast<root *>(rep.dat<void *>())->rc_biased::addref());
       }
    }
    MNL_INLINE inline void val::release() const noexcept {
       switch (rep.tag()) {
       case 0x7FFBu: rep.dat<const sym &>().release(); return;
-      case 0x7FF8u: if (MNL_UNLIKELY(! MNL_IF_WITHOUT_MT(--static_cast<root *>(rep.dat<void *>())->_rc)
-         MNL_IF_WITH_MT(__atomic_sub_fetch(&static_cast<root *>(rep.dat<void *>())->_rc, 1, __ATOMIC_ACQ_REL)) )) delete static_cast<root *>(rep.dat<void *>());
+      case 0x7FF8u: if (MNL_UNLIKELY( MNL_IF_WITHOUT_MT(!--static_cast<root *>(rep.dat<void *>())->_rc)
+         MNL_IF_WITH_MT(static_cast<root *>(rep.dat<void *>())->rc_biased::release()) )) delete static_cast<root *>(rep.dat<void *>());
       }
    }
 # else // alternative implementation
    MNL_INLINE inline void val::addref() const noexcept {
       if (MNL_UNLIKELY(rep.tag() == 0x7FF8u)) // should improve branch prediction compared to a switch
          MNL_IF_WITHOUT_MT(++static_cast<root *>(rep.dat<void *>())->_rc)
-         MNL_IF_WITH_MT(__atomic_add_fetch(&static_cast<root *>(rep.dat<void *>())->_rc, 1, __ATOMIC_RELAXED));
+         MNL_IF_WITH_MT(static_cast<root *>(rep.dat<void *>())->rc_biased::addref());
       else
       if (MNL_UNLIKELY(rep.tag() == 0x7FFBu))
          rep.dat<const sym &>().addref();
    }
    MNL_INLINE inline void val::release() const noexcept {
       if (MNL_UNLIKELY(rep.tag() == 0x7FF8u)) {
-         if (MNL_UNLIKELY(!
-            MNL_IF_WITHOUT_MT(--static_cast<root *>(rep.dat<void *>())->_rc)
-            MNL_IF_WITH_MT(__atomic_sub_fetch(&static_cast<root *>(rep.dat<void *>())->_rc, 1, __ATOMIC_ACQ_REL)) ))
+         if (MNL_UNLIKELY(
+            MNL_IF_WITHOUT_MT(!--static_cast<root *>(rep.dat<void *>())->_rc)
+            MNL_IF_WITH_MT(static_cast<root *>(rep.dat<void *>())->rc_biased::release()) ))
             delete static_cast<root *>(rep.dat<void *>());
       } else
       if (MNL_UNLIKELY(rep.tag() == 0x7FFBu)) {
@@ -602,8 +709,8 @@ namespace aux { namespace pub {
       template<typename Dat> MNL_INLINE friend Dat  cast(const code &rhs) noexcept
          { return static_cast<box<typename std::remove_cv<typename std::remove_reference<Dat>::type>::type> *>(rhs.rep)->dat; }
    private: // Concrete representation
-      class root { public:
-         /*atomic*/ long rc = 1;
+      class root MNL_IF_WITH_MT(: public aux::rc_biased) { public:
+         MNL_IF_WITHOUT_MT(long rc = 1;)
          virtual ~root() = default;
          virtual code compile(code &&self, const form &, const loc &) const = 0;
          virtual val  execute(bool fast_sig) const = 0;
@@ -624,9 +731,9 @@ namespace aux { namespace pub {
       };
    private: // Implementation helpers
       MNL_INLINE void addref() const noexcept
-         { if (MNL_LIKELY(rep)) MNL_IF_WITHOUT_MT(++rep->rc) MNL_IF_WITH_MT(__atomic_add_fetch(&rep->rc, 1, __ATOMIC_RELAXED)); }
+         { if (MNL_LIKELY(rep)) MNL_IF_WITHOUT_MT(++rep->rc) MNL_IF_WITH_MT(rep->addref()); }
       MNL_INLINE void release() const noexcept
-         { if (MNL_LIKELY(rep) && MNL_UNLIKELY(! MNL_IF_WITHOUT_MT(--rep->rc) MNL_IF_WITH_MT(__atomic_sub_fetch(&rep->rc, 1, __ATOMIC_ACQ_REL)) )) delete rep; }
+         { if (MNL_LIKELY(rep) && MNL_UNLIKELY( MNL_IF_WITHOUT_MT(!--rep->rc) MNL_IF_WITH_MT(rep->release()) )) delete rep; }
    private: // Support for <expr># expressions
       MNL_INLINE val invoke(val &&self, const sym &op, int argc, val argv[], val *) { return self.default_invoke(op, argc, argv); }
       friend mnl::box<code>;
@@ -719,6 +826,24 @@ namespace aux {
    template<typename Dat> MNL_INLINE inline enable_same<Dat, unsigned> _sub(Dat lhs, Dat rhs) { return lhs - rhs; }
    template<typename Dat> MNL_INLINE inline enable_same<Dat, unsigned> _mul(Dat lhs, Dat rhs) { return lhs * rhs; }
 
+   // Hash (results are nonnegative and fit in I48) ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+   MNL_INLINE inline long long _hash(unsigned long long key) noexcept { // SplitMix64 finalizer
+      key = (key ^ key >> 30) * 0xBF58476D1CE4E5B9u, key = (key ^ key >> 27) * 0x94D049BB133111EBu;
+      return (key ^ key >> 31) >> 64 - 47;
+   }
+   template<typename Dat> MNL_INLINE inline enable_core_binfloat<Dat, long long> _hash(Dat key) noexcept {
+      if (MNL_UNLIKELY(!key)) return 0; // +0.0 == -0.0
+      double tmp = key; unsigned long long res; memcpy(&res, &tmp, sizeof res); return _hash(res);
+   }
+   MNL_INLINE inline long long _hash(const char *dat, size_t size) noexcept { // FNV-1a, as for both short and boxed Strings
+      unsigned long long res = 0xCBF29CE484222325u;
+      for (; size; --size) res = (res ^ (unsigned char)*dat++) * 0x100000001B3u;
+      return _hash(res);
+   }
+   MNL_INLINE inline long long _hash_combine(long long lhs, long long rhs) noexcept
+      { return _hash((unsigned long long)lhs * 0x9E3779B97F4A7C15u ^ rhs); }
+
 } // namespace aux
 
 namespace aux { namespace pub {
@@ -728,6 +853,8 @@ namespace aux { namespace pub {
          return static_cast<root *>(rep.dat<void *>())->invoke(move(*this), MNL_SYM("Apply"), argc, argv, argv_out);
       if (MNL_LIKELY(rep.tag() == 0x7FFBu)) // Sym
          return cast<const sym &>()(argc, argv, argv_out);
+      if (MNL_LIKELY(rep.tag() == 0xFFF8u)) // short String
+         return move(*this)._apply_short_string(argc, argv, argv_out);
       MNL_ERR(MNL_SYM("UnrecognizedOperation"));
    }
 
@@ -781,10 +908,14 @@ namespace aux { namespace pub {
    template<typename Dat> MNL_INLINE inline enable_same<Dat, sym, val> _ne(val &&lhs, const Dat &rhs)
       { if (MNL_LIKELY(test<sym>(lhs))) return cast<const sym &>(lhs) != rhs; return _ne(move(lhs), (val)rhs); }
 
-   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, val> _eq(val &&lhs, const Dat &rhs)
-      { if (MNL_LIKELY(test<string>(lhs))) return cast<const string &>(lhs) == rhs; return _eq(move(lhs), (val)rhs); }
-   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, val> _ne(val &&lhs, const Dat &rhs)
-      { if (MNL_LIKELY(test<string>(lhs))) return cast<const string &>(lhs) != rhs; return _ne(move(lhs), (val)rhs); }
+   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, val> _eq(val &&lhs, const Dat &rhs) {
+      if (MNL_LIKELY(test<string>(lhs))) return cast<const string &>(lhs) == rhs;
+      if (lhs.is_string() && !test<string_slice>(lhs) && rhs.size() > val::short_string_max) return false; return _eq(move(lhs), (val)rhs);
+   }
+   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, val> _ne(val &&lhs, const Dat &rhs) {
+      if (MNL_LIKELY(test<string>(lhs))) return cast<const string &>(lhs) != rhs;
+      if (lhs.is_string() && !test<string_slice>(lhs) && rhs.size() > val::short_string_max) return true;  return _ne(move(lhs), (val)rhs);
+   }
 
    template<typename Dat> MNL_INLINE inline enable_same<Dat, decltype(nullptr), val> _eq(val &&lhs, Dat)
       { if (test<>(lhs)) return true;  return _eq(move(lhs), (val)nullptr); }
@@ -796,10 +927,13 @@ namespace aux { namespace pub {
    template<typename Dat> MNL_INLINE inline enable_same<Dat, sym, bool> _ne(const Dat &lhs, val &&rhs) noexcept
       { return !MNL_LIKELY(test<sym>(rhs)) || lhs != cast<const sym &>(rhs); }
 
-   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, bool> _eq(const Dat &lhs, val &&rhs) noexcept
-      { return  MNL_LIKELY(test<string>(rhs)) && lhs == cast<const string &>(rhs); }
+   template<typename Dat> MNL_INLINE inline enable_same<Dat, string, bool> _eq(const Dat &lhs, val &&rhs) noexcept {
+      return MNL_LIKELY(test<string>(rhs)) ? lhs == cast<const string &>(rhs) :
+         MNL_UNLIKELY(test<string_slice>(rhs)) ? !lhs.compare(0, string::npos, cast<const string_slice &>(rhs).data(), cast<const string_slice &>(rhs).size) :
+         lhs.size() <= val::short_string_max && rhs.is_string() && cast<bool>(_eq((val)lhs, move(rhs))); // no allocation involved
+   }
    template<typename Dat> MNL_INLINE inline enable_same<Dat, string, bool> _ne(const Dat &lhs, val &&rhs) noexcept
-      { return !MNL_LIKELY(test<string>(rhs)) || lhs != cast<const string &>(rhs); }
+      { return !_eq(lhs, move(rhs)); }
 
    template<typename Dat> MNL_INLINE inline enable_same<Dat, decltype(nullptr), bool> _eq(Dat, val &&rhs) noexcept
       { return  test<>(rhs); }
@@ -815,6 +949,47 @@ namespace aux { namespace pub {
    extern template class box<proc_Min>;
    extern template class box<proc_Max>;
 
+// Inline Caches ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux {
+   // Per-call-site cache for invocations of a Symbol (as in Size[A] or A.Push[V]), keyed on the dynamic type of the receiver (argv[0]); on a hit, the final
+   // overrider of val::root::invoke resolved on a miss is called directly, which bypasses sym::operator() and the virtual dispatch. Up to 4 receiver types
+   // per site (polymorphic), then no more entries are made (megamorphic). Entries are written once and published with release semantics, so lookups are
+   // lock-free in MT builds. Copies start out empty. Resolving the overrider relies on the GNU C++ extension for extracting the function pointer from a
+   // bound pointer to member function, which clang lacks, so with clang the cache is compiled out and every call goes straight to sym::operator().
+   class apply_cache {
+   public:
+      apply_cache() = default;
+      MNL_INLINE apply_cache(const apply_cache &) noexcept {}
+      MNL_INLINE apply_cache &operator=(const apply_cache &) noexcept { return *this; }
+   public:
+      MNL_INLINE val operator()(const sym &target, int argc, val argv[]) const {
+      # if !__clang__
+         if (MNL_LIKELY(argc) && MNL_LIKELY(argv[0].rep.tag() == 0x7FF8u)) { // BoxPtr
+            auto root = static_cast<val::root *>(argv[0].rep.dat<void *>());
+            auto type = *reinterpret_cast<const void *const *>(root); // vptr
+            for (auto &&el: ents) {
+               auto key = MNL_IF_WITHOUT_MT(el.key) MNL_IF_WITH_MT(__atomic_load_n(&el.key, __ATOMIC_ACQUIRE));
+               if (MNL_LIKELY(key == type)) return el.target(root, move(argv[0]), target, argc - 1, argv + 1, {});
+               if (!key) return miss(target, argc, argv);
+            }
+         }
+      # endif
+         return target(argc, argv);
+      }
+      MNL_INLINE val operator()(val &&target, int argc, val argv[]) const {
+         if (MNL_LIKELY(target.rep.tag() == 0x7FFBu)) return (*this)(target.rep.dat<const sym &>(), argc, argv);
+         return move(target)(argc, argv);
+      }
+   # if !__clang__
+   private:
+      typedef val (*handler)(val::root *, val &&, const sym &, int, val [], val *);
+      mutable struct { const void *key; handler target; } ents[4]{};
+      MNL_IF_WITH_MT(mutable bool busy{};)
+      val miss(const sym &, int, val []) const;
+   # endif
+   };
+} // namespace aux
+
 // Convenience Routines ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 namespace aux { namespace pub {
    template<typename Dat> MNL_INLINE inline Dat safe_cast(const val &rhs)
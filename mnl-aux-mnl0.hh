@@ -67,6 +67,11 @@
    # define MNL_INLINE
    # define MNL_NOINLINE
 # endif
+# if MNL_USE_TARGET_CLONES && __x86_64__ && (!__clang__ ? __GNUC__ >= 6 : __clang_major__ >= 14) // relies on IFUNC support
+   # define MNL_SIMD_CLONES __attribute__((__target_clones__("avx2", "default")))
+# else
+   # define MNL_SIMD_CLONES
+# endif
 #
 # define MNL_NORETURN      __attribute__((__noreturn__, __noinline__, __cold__))
 # define MNL_UNREACHABLE() __builtin_unreachable()
@@ -16,14 +16,61 @@
 # ifndef MNL_INCLUDED_BASE
 # define MNL_INCLUDED_BASE
 
-# include <list>
+# include <deque>
 # include "manool.hh"
 # include "mnl-misc-dict.hh"
+# include "mnl-misc-bdict.hh"
+# include "mnl-misc-pdict.hh"
+# include "mnl-misc-hdict.hh"
 
 namespace MNL_AUX_UUID {
 
 namespace aux { namespace pub {
-   MNL_INLINE inline long long order(val lhs, val rhs) { return safe_cast<long long>(MNL_SYM("Order")(args<2>{move(lhs), move(rhs)})); } // Ordering for dict<val, *>
+   template<typename Dat> MNL_INLINE inline long long _order(Dat lhs, Dat rhs) noexcept // as for F64 and F32 Order
+      { return std::signbit(lhs) ^ std::signbit(rhs) ? std::signbit(rhs) - std::signbit(lhs) : lhs < rhs ? -1 : lhs != rhs; }
+   MNL_INLINE inline long long order(const val &lhs, const val &rhs) { // Ordering for dict<val, *> (the same results as for Order, which is only invoked for other types)
+      if (MNL_LIKELY(test<long long>(lhs))) return MNL_LIKELY(test<long long>(rhs)) ?
+         (cast<long long>(lhs) > cast<long long>(rhs)) - (cast<long long>(lhs) < cast<long long>(rhs)) : lhs.default_order(rhs);
+      {  const char *l, *r; size_t l_size, r_size; // Strings in any representation (short, boxed, or slices)
+         if (MNL_LIKELY(lhs.string_data(l, l_size)) && MNL_LIKELY(rhs.string_data(r, r_size))) { // lexicographic, as for box<string>
+            auto res = memcmp(l, r, std::min(l_size, r_size));
+            return res ? (res > 0) - (res < 0) : (l_size > r_size) - (l_size < r_size);
+         }
+      }
+      if (MNL_LIKELY(test<sym>(lhs))) return MNL_LIKELY(test<sym>(rhs)) ?
+         (cast<const sym &>(rhs) < cast<const sym &>(lhs)) - (cast<const sym &>(lhs) < cast<const sym &>(rhs)) : lhs.default_order(rhs);
+      if (test<double>(lhs)) return MNL_LIKELY(test<double>(rhs)) ? _order(cast<double>(lhs), cast<double>(rhs)) : lhs.default_order(rhs);
+      if (test<float>(lhs))  return MNL_LIKELY(test<float>(rhs))  ? _order(cast<float>(lhs),  cast<float>(rhs))  : lhs.default_order(rhs);
+      return safe_cast<long long>(MNL_SYM("Order")(args<2>{lhs, rhs}));
+   }
+# if MNL_USE_PERSISTENT_DICT
+   template<typename Val> class dict<val, Val, default_order<val>>: public pdict<val, Val> { // backing store for Map and Set (takes precedence)
+   public:
+      dict() = default;
+      using pdict<val, Val>::pdict;
+   };
+# elif MNL_USE_BTREE_DICT
+   template<typename Val> class dict<val, Val, default_order<val>>: public bdict<val, Val> { // backing store for Map and Set (with -UMNL_USE_PERSISTENT_DICT)
+   public:
+      dict() = default;
+      using bdict<val, Val>::bdict;
+   };
+# endif
+   MNL_INLINE inline long long hash(const val &key) { // Hashing for hdict<val, *> (the same results as for Hash)
+      if (MNL_LIKELY(test<long long>(key))) return _hash(cast<long long>(key));
+      {  const char *dat; size_t size; if (MNL_LIKELY(key.string_data(dat, size))) return _hash(dat, size); } // Strings in any representation
+      if (MNL_LIKELY(test<sym>(key))) return _hash(reinterpret_cast<uintptr_t>(&(const string &)cast<const sym &>(key)));
+      return safe_cast<long long>(MNL_SYM("Hash")(key));
+   }
+   MNL_INLINE inline bool equal(const val &lhs, const val &rhs) { // Equivalence for hdict<val, *>
+      if (MNL_LIKELY(test<long long>(lhs))) return MNL_LIKELY(test<long long>(rhs)) && cast<long long>(lhs) == cast<long long>(rhs);
+      {  const char *l, *r; size_t l_size, r_size; // Strings in any representation
+         if (MNL_LIKELY(lhs.string_data(l, l_size))) return MNL_LIKELY(rhs.string_data(r, r_size)) ? l_size == r_size && !memcmp(l, r, l_size) :
+            safe_cast<bool>(MNL_SYM("==")(args<2>{lhs, rhs}));
+      }
+      if (MNL_LIKELY(test<sym>(lhs))) return MNL_LIKELY(test<sym>(rhs)) && cast<const sym &>(lhs) == cast<const sym &>(rhs);
+      return safe_cast<bool>(MNL_SYM("==")(args<2>{lhs, rhs}));
+   }
 
    // MANOOL Pointers //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    class w_pointer /*weak pointer*/ {
@@ -49,12 +96,29 @@ namespace aux { namespace pub {
       MNL_INLINE inline val invoke(val &&, const sym &, int, val [], val *);
       friend box<s_pointer>;
    } pointer;
+
+   // Reductions and Element-wise Maps over Arrays /////////////////////////////////////////////////////////////////////////////////////////////////////////////
+   class proc_Sum  { static val invoke(val &&, const sym &, int, val [], val *); friend box<proc_Sum>; };
+   class proc_Dot  { static val invoke(val &&, const sym &, int, val [], val *); friend box<proc_Dot>; };
+   class proc_Map2 { static val invoke(val &&, const sym &, int, val [], val *); friend box<proc_Map2>; };
+   template<bool Max> class proc_Extremum { static val invoke(val &&, const sym &, int, val [], val *); friend box<proc_Extremum>; }; // Min[Array], Max[Array]
 }} // namespace aux::pub
    template<> val box<dict<val, val>> :: invoke(val &&, const sym &, int, val [], val *); // Map
    template<> val box<dict<val>>      :: invoke(val &&, const sym &, int, val [], val *); // Set
-   template<> val box<std::list<val>> :: invoke(val &&, const sym &, int, val [], val *); // Sequence
+   template<> val box<std::deque<val>>:: invoke(val &&, const sym &, int, val [], val *); // Sequence
+   template<> val box<hdict<val, val>>:: invoke(val &&, const sym &, int, val [], val *); // HashMap
+   template<> val box<hdict<val>>     :: invoke(val &&, const sym &, int, val [], val *); // HashSet
+   template<> val box<std::vector<double>>   :: invoke(val &&, const sym &, int, val [], val *); // F64Array
+   template<> val box<std::vector<float>>    :: invoke(val &&, const sym &, int, val [], val *); // F32Array
+   template<> val box<std::vector<long long>>:: invoke(val &&, const sym &, int, val [], val *); // I48Array
+   template<> val box<std::vector<unsigned>> :: invoke(val &&, const sym &, int, val [], val *); // U32Array
    extern template class box<w_pointer>;
    extern template class box<s_pointer>;
+   extern template class box<proc_Sum>;
+   extern template class box<proc_Dot>;
+   extern template class box<proc_Map2>;
+   extern template class box<proc_Extremum<false>>;
+   extern template class box<proc_Extremum<true>>;
 
 } // namespace MNL_AUX_UUID
 
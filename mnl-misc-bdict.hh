@@ -0,0 +1,460 @@
+// mnl-misc-bdict.hh -- B-tree variant of the dictionary ADT (see mnl-misc-dict.hh)
+
+/*    Copyright (C) 2018, 2019, 2020 Alexey Protasov (AKA Alex or rusini)
+
+   This file is part of MANOOL.
+
+   MANOOL is free software: you can redistribute it and/or modify it under the terms of the version 3 of the GNU General Public License
+   as published by the Free Software Foundation (and only version 3).
+
+   MANOOL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with MANOOL.  If not, see <https://www.gnu.org/licenses/>.  */
+
+
+# ifndef MNL_INCLUDED_BDICT
+# define MNL_INCLUDED_BDICT
+
+# include <new>         // placement new
+# include <type_traits> // aligned_storage, is_nothrow_move_constructible
+# include "mnl-misc-dict.hh"
+
+namespace MNL_AUX_UUID {
+
+namespace aux {
+   template<typename Key, typename Val, typename Ord, typename RetVal> class bdict_iterator;
+} // namespace aux
+
+namespace aux { namespace pub {
+   // Same interface and guarantees as dict, but up to max_count entries are kept per node, so that a lookup touches few cache lines
+   // (note that iterators are invalidated by any modification, unlike for dict):
+   template<typename Key, typename Val = dict_val_empty, typename Ord = default_order<Key>> class bdict {
+      static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value,
+         "std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value");
+   public: // Typedefs mostly conforming to STL associative containers (most are unused in MANOOL) - no allocator_type
+      typedef Key                                             key_type;
+      typedef Val                                             mapped_type;
+      typedef pair<const key_type, mapped_type>               value_type;
+      typedef Ord                                             key_order; // dict-specific - instead of key_compare and value_compare
+      typedef value_type                                      &reference;
+      typedef const value_type                                &const_reference;
+      typedef bdict_iterator<Key, Val, Ord, value_type>       iterator;
+      typedef bdict_iterator<Key, Val, Ord, const value_type> const_iterator;
+      typedef size_t                                          size_type;
+      typedef ptrdiff_t                                       difference_type;
+      typedef value_type                                      *pointer;
+      typedef const value_type                                *const_pointer;
+      typedef std::reverse_iterator<iterator>                 reverse_iterator;
+      typedef std::reverse_iterator<const_iterator>           const_reverse_iterator;
+   public: // Standard operations
+      bdict() = default;
+   public:
+      bdict(const bdict &rhs): ord(rhs.ord), root(clone(rhs.root)), count(rhs.count) {}
+      bdict(bdict &&rhs): ord((move)(rhs.ord)), root(rhs.root), count(rhs.count) {
+         rhs.root = {}; rhs.count = {}; // left in an indeterminate but completely consistent state, as in STL
+      }
+      bdict &operator=(const bdict &rhs) {
+         if (&rhs != this) {
+            auto root = clone(rhs.root); try { ord = rhs.ord; } catch (...) { dispose(root), throw; }
+            (dispose(bdict::root), bdict::root) = root; count = rhs.count;
+         }
+         return *this;
+      }
+      bdict &operator=(bdict &&rhs) {
+         swap(rhs);
+         return *this;
+      }
+      ~bdict() {
+         dispose(root);
+      }
+      void swap(bdict &rhs) {
+         using std::swap; swap(ord, rhs.ord); swap(root, rhs.root); swap(count, rhs.count);
+      }
+   public: // Dict-specific operations
+      explicit bdict(Ord ord)
+         : ord((move)(ord)) {}
+      void set(pair<Key, Val> data)
+         { insert(move(data)); }
+      void set(Key key, Val val)
+         { set(make_pair((move)(key), (move)(val))); }
+      void set(Key key)
+         { set(make_pair((move)(key), Val{})); }
+      void unset(const Key &key)
+         { remove(key); }
+      template<typename InIt> void assign_sorted(InIt first, size_type size); // as for dict
+   public: // Strictly conforming to STL associative containers
+      iterator find(const key_type &);
+      const_iterator find(const key_type &) const;
+      iterator begin() noexcept, end() noexcept;
+      const_iterator begin() const noexcept, end() const noexcept;
+      reverse_iterator rbegin() noexcept, rend() noexcept;
+      const_reverse_iterator rbegin() const noexcept, rend() const noexcept;
+      const_iterator cbegin() const noexcept, cend() const noexcept;
+      const_reverse_iterator crbegin() const noexcept, crend() const noexcept;
+   public: // Mostly conforming to STL associative containers
+      Ord key_ord() const { return ord; }
+      Val &operator[](const Key &key) { return find(key)->second; }
+      const Val &operator[](const Key & key) const { return find(key)->second; }
+   private: // Concrete representation
+      static const int min_count = 16, max_count = 2 * min_count + 1; // entries per node (except that the root may have less than min_count)
+      Ord ord = {};
+      struct node;
+      struct inner;
+      node *root = {};
+      size_type count = {};
+      static const auto left = false, right = true;
+      friend iterator;
+      friend const_iterator;
+   private: // B-tree helpers (CLRS-style single-pass insertion and removal; all restructuring is done without calling ord)
+      static node *&child(const node *, int) noexcept;
+      static node *new_node(bool leaf);
+      static void delete_node(node *) noexcept;
+      static void relink(node *, int from, int to) noexcept;
+      static void move_entry(node *dst, int, node *src, int) noexcept;
+      static void insert_entry(node *, int, pair<Key, Val> &&, node *child = {}) noexcept;
+      static void erase_entry(node *, int) noexcept;
+      static void split(node *, int, node *) noexcept;
+      static void merge(node *, int) noexcept;
+      static int fill(node *, int) noexcept;
+      template<bool> static pair<Key, Val> remove_most(node *) noexcept;
+      static void remove_at(node *, int) noexcept;
+      void shrink() noexcept;
+      int search(const node *, const Key &, bool &found) const;
+      void insert(pair<Key, Val> &&);
+      void remove(const Key &);
+      static node *clone(const node *);
+      static void dispose(node *) noexcept;
+      struct level { size_type base, rem, index; }; // layout of a level for assign_sorted
+      template<typename InIt> static node *build(InIt &, level [], int);
+      template<bool> node *find_most() const noexcept;
+   public: // Strictly conforming to STL containers
+      bool empty() const noexcept { return !size(); }
+      size_type size() const noexcept { return count; }
+      size_type max_size() const noexcept { return size_type(-1) / sizeof(value_type); }
+      void clear() noexcept { (dispose(root), root) = {}; count = {}; }
+   };
+   template<typename Key, typename Val, typename Ord> inline void swap(bdict<Key, Val, Ord> &lhs, bdict<Key, Val, Ord> &rhs)
+      { lhs.swap(rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator==(const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+   template<typename Key, typename Val, typename Ord> inline bool operator< (const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+   template<typename Key, typename Val, typename Ord> inline bool operator!=(const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator!=(lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator> (const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator> (lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator<=(const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator<=(lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator>=(const bdict<Key, Val, Ord> &lhs, const bdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator>=(lhs, rhs); }
+
+   template<typename Key, typename Val, typename Ord> struct bdict<Key, Val, Ord>::node {
+      node *parent; int index; // position in parent
+      int  size; bool leaf;
+      typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type data[max_count];
+      value_type &operator[](int sn) noexcept { return reinterpret_cast<value_type &>(data[sn]); }
+      const value_type &operator[](int sn) const noexcept { return reinterpret_cast<const value_type &>(data[sn]); }
+   };
+   template<typename Key, typename Val, typename Ord> struct bdict<Key, Val, Ord>::inner: node {
+      node *child[max_count + 1];
+   };
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::node *&bdict<Key, Val, Ord>::child(const node *root, int sn) noexcept {
+      return static_cast<inner *>(const_cast<node *>(root))->child[sn];
+   }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::node *bdict<Key, Val, Ord>::new_node(bool leaf) {
+      node *res = leaf ? new node : new inner;
+      return res->parent = {}, res->index = 0, res->size = 0, res->leaf = leaf, res;
+   }
+   template<typename Key, typename Val, typename Ord> inline void bdict<Key, Val, Ord>::delete_node(node *root) noexcept {
+      if (root->leaf) delete root; else delete static_cast<inner *>(root);
+   }
+   template<typename Key, typename Val, typename Ord> inline void bdict<Key, Val, Ord>::relink(node *root, int from, int to) noexcept {
+      for (; from < to; ++from) child(root, from)->parent = root, child(root, from)->index = from;
+   }
+   template<typename Key, typename Val, typename Ord> inline void bdict<Key, Val, Ord>::move_entry(node *dst, int dst_sn, node *src, int src_sn) noexcept {
+      // moving out of a const Key that is about to be destroyed anyway (as std::map node extraction does)
+      new (&dst->data[dst_sn]) value_type(move(const_cast<Key &>((*src)[src_sn].first)), move((*src)[src_sn].second)), (*src)[src_sn].~value_type();
+   }
+   template<typename Key, typename Val, typename Ord>
+   void bdict<Key, Val, Ord>::insert_entry(node *root, int sn, pair<Key, Val> &&data, node *right_child) noexcept { // precond: root->size < max_count
+      for (int dst = root->size; dst > sn; --dst) move_entry(root, dst, root, dst - 1);
+      new (&root->data[sn]) value_type(move(data.first), move(data.second));
+      if (!root->leaf) {
+         for (int dst = root->size + 1; dst > sn + 1; --dst) child(root, dst) = child(root, dst - 1);
+         child(root, sn + 1) = right_child, relink(root, sn + 1, root->size + 2);
+      }
+      ++root->size;
+   }
+   template<typename Key, typename Val, typename Ord> void bdict<Key, Val, Ord>::erase_entry(node *root, int sn) noexcept { // precond: root->leaf
+      (*root)[sn].~value_type();
+      for (int dst = sn; dst < root->size - 1; ++dst) move_entry(root, dst, root, dst + 1);
+      --root->size;
+   }
+   template<typename Key, typename Val, typename Ord>
+   void bdict<Key, Val, Ord>::split(node *root, int sn, node *res) noexcept { // precond: child(root, sn)->size == max_count, res is empty and of the same kind
+      auto lhs = child(root, sn);
+      for (int src = min_count + 1; src < max_count; ++src) move_entry(res, src - (min_count + 1), lhs, src);
+      if (!lhs->leaf) {
+         for (int src = min_count + 1; src <= max_count; ++src) child(res, src - (min_count + 1)) = child(lhs, src);
+         relink(res, 0, min_count + 1);
+      }
+      pair<Key, Val> median{move(const_cast<Key &>((*lhs)[min_count].first)), move((*lhs)[min_count].second)};
+      (*lhs)[min_count].~value_type(), lhs->size = res->size = min_count;
+      insert_entry(root, sn, move(median), res);
+   }
+   template<typename Key, typename Val, typename Ord>
+   void bdict<Key, Val, Ord>::merge(node *root, int sn) noexcept { // precond: both children have min_count entries at most
+      auto lhs = child(root, sn), rhs = child(root, sn + 1);
+      move_entry(lhs, lhs->size, root, sn);
+      for (int src = 0; src < rhs->size; ++src) move_entry(lhs, lhs->size + 1 + src, rhs, src);
+      if (!lhs->leaf) {
+         for (int src = 0; src <= rhs->size; ++src) child(lhs, lhs->size + 1 + src) = child(rhs, src);
+         relink(lhs, lhs->size + 1, lhs->size + rhs->size + 2);
+      }
+      lhs->size += rhs->size + 1;
+      for (int dst = sn; dst < root->size - 1; ++dst) move_entry(root, dst, root, dst + 1);
+      for (int dst = sn + 1; dst < root->size; ++dst) child(root, dst) = child(root, dst + 1);
+      --root->size, relink(root, sn + 1, root->size + 1);
+      rhs->size = 0, delete_node(rhs);
+   }
+   template<typename Key, typename Val, typename Ord>
+   int bdict<Key, Val, Ord>::fill(node *root, int sn) noexcept { // ensures the child to descend into has more than min_count entries
+      auto target = child(root, sn);
+      if (target->size > min_count) return sn;
+      if (sn > 0 && child(root, sn - 1)->size > min_count) { // borrow from the left sibling
+         auto lhs = child(root, sn - 1);
+         for (int dst = target->size; dst > 0; --dst) move_entry(target, dst, target, dst - 1);
+         move_entry(target, 0, root, sn - 1), move_entry(root, sn - 1, lhs, lhs->size - 1);
+         if (!target->leaf) {
+            for (int dst = target->size + 1; dst > 0; --dst) child(target, dst) = child(target, dst - 1);
+            child(target, 0) = child(lhs, lhs->size), relink(target, 0, target->size + 2);
+         }
+         ++target->size, --lhs->size;
+         return sn;
+      }
+      if (sn < root->size && child(root, sn + 1)->size > min_count) { // borrow from the right sibling
+         auto rhs = child(root, sn + 1);
+         move_entry(target, target->size, root, sn), move_entry(root, sn, rhs, 0);
+         for (int dst = 0; dst < rhs->size - 1; ++dst) move_entry(rhs, dst, rhs, dst + 1);
+         if (!target->leaf) {
+            child(target, target->size + 1) = child(rhs, 0), relink(target, target->size + 1, target->size + 2);
+            for (int dst = 0; dst < rhs->size; ++dst) child(rhs, dst) = child(rhs, dst + 1);
+            relink(rhs, 0, rhs->size);
+         }
+         ++target->size, --rhs->size;
+         return sn;
+      }
+      if (sn < root->size) return merge(root, sn), sn;
+      return merge(root, sn - 1), sn - 1;
+   }
+   template<typename Key, typename Val, typename Ord>
+   template<bool dir> pair<Key, Val> bdict<Key, Val, Ord>::remove_most(node *root) noexcept { // precond: root->size > min_count
+      while (!root->leaf) root = child(root, fill(root, dir ? root->size : 0));
+      auto sn = dir ? root->size - 1 : 0;
+      pair<Key, Val> res{move(const_cast<Key &>((*root)[sn].first)), move((*root)[sn].second)};
+      return erase_entry(root, sn), res;
+   }
+   template<typename Key, typename Val, typename Ord> void bdict<Key, Val, Ord>::remove_at(node *root, int sn) noexcept {
+      for (;;) {
+         if (root->leaf) return erase_entry(root, sn);
+         if (child(root, sn)->size > min_count || child(root, sn + 1)->size > min_count) {
+            auto data = child(root, sn)->size > min_count ? remove_most<right>(child(root, sn)) : remove_most<left>(child(root, sn + 1));
+            (*root)[sn].~value_type(), new (&root->data[sn]) value_type(move(data.first), move(data.second));
+            return;
+         }
+         merge(root, sn), root = child(root, sn), sn = min_count;
+      }
+   }
+   template<typename Key, typename Val, typename Ord> inline void bdict<Key, Val, Ord>::shrink() noexcept {
+      if (root->size) return;
+      auto res = root->leaf ? nullptr : child(root, 0);
+      if (res) res->parent = {}, res->index = 0;
+      delete_node(root), root = res;
+   }
+   template<typename Key, typename Val, typename Ord> int bdict<Key, Val, Ord>::search(const node *root, const Key &key, bool &found) const {
+      int lo = 0, hi = root->size;
+      while (lo < hi) { // whatever ord returns, the result is in [0, root->size]
+         auto mid = (lo + hi) / 2; auto ord = bdict::ord(key, (*root)[mid].first);
+         if (ord < 0) hi = mid; else if (ord > 0) lo = mid + 1; else return found = true, mid;
+      }
+      return found = false, lo;
+   }
+   template<typename Key, typename Val, typename Ord> void bdict<Key, Val, Ord>::insert(pair<Key, Val> &&data) {
+      if (!root) root = new_node(true);
+      else if (root->size == max_count) {
+         auto res = new_node(false), rhs = (node *){};
+         try { rhs = new_node(root->leaf); } catch (...) { delete_node(res); throw; }
+         child(res, 0) = root, relink(res, 0, 1), root = res, split(root, 0, rhs);
+      }
+      for (auto root = bdict::root;;) {
+         bool found; auto sn = search(root, data.first, found);
+         if (found) return (*root)[sn].second = (move)(data.second), void();
+         if (root->leaf) return insert_entry(root, sn, move(data)), ++count, void();
+         if (child(root, sn)->size == max_count) {
+            split(root, sn, new_node(child(root, sn)->leaf));
+            auto ord = bdict::ord(data.first, (*root)[sn].first);
+            if (!ord) return (*root)[sn].second = (move)(data.second), void();
+            if (ord > 0) ++sn;
+         }
+         root = child(root, sn);
+      }
+   }
+   template<typename Key, typename Val, typename Ord> void bdict<Key, Val, Ord>::remove(const Key &key) {
+      for (auto root = bdict::root; root;) {
+         bool found; auto sn = search(root, key, found);
+         if (found) return remove_at(root, sn), --count, shrink();
+         if (root->leaf) return;
+         sn = fill(root, sn);
+         if (root == bdict::root && !root->size) shrink(), root = bdict::root; else root = child(root, sn);
+      }
+   }
+   template<typename Key, typename Val, typename Ord> typename bdict<Key, Val, Ord>::node *bdict<Key, Val, Ord>::clone(const node *root) {
+      if (!root) return {};
+      auto res = new_node(root->leaf);
+      try {
+         for (; res->size < root->size; ++res->size) new (&res->data[res->size]) value_type((*root)[res->size]);
+         if (!res->leaf) {
+            for (int sn = 0; sn <= root->size; ++sn)
+               try { child(res, sn) = clone(child(root, sn)); } catch (...) { for (; sn; --sn) dispose(child(res, sn - 1)); throw; }
+            relink(res, 0, res->size + 1);
+         }
+      } catch (...) {
+         for (; res->size; --res->size) (*res)[res->size - 1].~value_type();
+         delete_node(res); throw;
+      }
+      return res;
+   }
+   template<typename Key, typename Val, typename Ord> void bdict<Key, Val, Ord>::dispose(node *root) noexcept {
+      if (!root) return;
+      if (!root->leaf) for (int sn = 0; sn <= root->size; ++sn) dispose(child(root, sn));
+      for (int sn = 0; sn < root->size; ++sn) (*root)[sn].~value_type();
+      delete_node(root);
+   }
+   template<typename Key, typename Val, typename Ord> template<typename InIt> void bdict<Key, Val, Ord>::assign_sorted(InIt first, size_type size) {
+      // bottom-up planning: each level holds as few nodes as possible, entries are spread evenly (at least min_count per node, except for the root),
+      // and all but one entry of the level below go to the nodes, the rest being their separators
+      level levels[sizeof(size_type) * 8]; int height = 0;
+      for (auto entries = size; entries;) {
+         auto nodes = (entries + 1 + max_count) / (max_count + 1);
+         levels[height++] = {(entries - (nodes - 1)) / nodes, (entries - (nodes - 1)) % nodes, 0}, entries = nodes - 1;
+      }
+      auto root = height ? build(first, levels, height - 1) : nullptr;
+      clear(), bdict::root = root, count = size;
+   }
+   template<typename Key, typename Val, typename Ord>
+   template<typename InIt> typename bdict<Key, Val, Ord>::node *bdict<Key, Val, Ord>::build(InIt &first, level levels[], int height) { // in-order traversal
+      auto res = new_node(!height);
+      auto size = int(levels[height].base + (levels[height].index < levels[height].rem)); ++levels[height].index;
+      try {
+         for (;; ++first, ++res->size) {
+            if (height) child(res, res->size) = build(first, levels, height - 1);
+            if (res->size == size) break;
+            new (&res->data[res->size]) value_type(move(first->first), move(first->second));
+         }
+      } catch (...) {
+         for (int sn = 0; sn < res->size; ++sn) { if (height) dispose(child(res, sn)); (*res)[sn].~value_type(); }
+         delete_node(res); throw;
+      }
+      if (height) relink(res, 0, res->size + 1);
+      return res;
+   }
+   template<typename Key, typename Val, typename Ord> template<bool dir> inline typename bdict<Key, Val, Ord>::node *bdict<Key, Val, Ord>::find_most() const noexcept {
+      if (!root) return {};
+      auto res = root;
+      while (!res->leaf) res = child(res, dir ? res->size : 0);
+      return res;
+   }
+}} // namespace aux::pub
+
+// Iterators ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux {
+   template<typename Key, typename Val, typename Ord, typename IterVal>
+   class bdict_iterator: public std::iterator<std::bidirectional_iterator_tag, IterVal> { // Strictly conforming to STL bidirectional iterators
+   public: // Standard operations
+      bdict_iterator() = default;
+      template<typename Key_, typename Val_, typename Ord_, typename LRetVal_, typename RRetVal_> friend bool
+         operator==(bdict_iterator<Key_, Val_, Ord_, LRetVal_>, bdict_iterator<Key_, Val_, Ord_, RRetVal_>) noexcept;
+      template<typename Key_, typename Val_, typename Ord_, typename LRetVal_, typename RRetVal_> friend bool
+         operator!=(bdict_iterator<Key_, Val_, Ord_, LRetVal_>, bdict_iterator<Key_, Val_, Ord_, RRetVal_>) noexcept;
+   public: // Conforming to STL
+      IterVal &operator*() const noexcept { return (*node)[sn]; }
+      IterVal *operator->() const noexcept { return &*(*this); }
+      bdict_iterator &operator++() noexcept { goto_next<bdict<Key, Val, Ord>::right>(); return *this; }
+      bdict_iterator &operator--() noexcept {
+         if (node) goto_next<bdict<Key, Val, Ord>::left>(); else if (node = owner->template find_most<bdict<Key, Val, Ord>::right>()) sn = node->size - 1;
+         return *this;
+      }
+      bdict_iterator operator++(int) noexcept { auto res = *this; ++(*this); return res; }
+      bdict_iterator operator--(int) noexcept { auto res = *this; --(*this); return res; }
+      operator bdict_iterator<Key, Val, Ord, const IterVal>() const noexcept { return {owner, node, sn}; }
+   private: // Concrete representation
+      typename bdict<Key, Val, Ord>::node *node;
+      int sn;
+      const bdict<Key, Val, Ord> *owner;
+      bdict_iterator(decltype(owner) owner, decltype(node) node, int sn = 0) noexcept: node(node), sn(sn), owner(owner) {}
+      friend class bdict<Key, Val, Ord>;
+      friend class bdict_iterator<Key, Val, Ord, typename std::remove_const<IterVal>::type>;
+   private: // Implementation helpers
+      template<bool dir> void goto_next() noexcept {
+         if (!node->leaf) {
+            for (node = bdict<Key, Val, Ord>::child(node, sn + dir); !node->leaf; node = bdict<Key, Val, Ord>::child(node, dir ? 0 : node->size));
+            sn = dir ? 0 : node->size - 1;
+         } else if (dir ? ++sn == node->size : sn-- == 0) {
+            int index; do index = node->index, node = node->parent; while (node && index == (dir ? node->size : 0));
+            sn = node ? index - !dir : 0;
+         }
+      }
+   };
+   template<typename Key, typename Val, typename Ord, typename LRetVal, typename RRetVal> inline bool
+      operator==(bdict_iterator<Key, Val, Ord, LRetVal> lhs, bdict_iterator<Key, Val, Ord, RRetVal> rhs) noexcept { return lhs.node == rhs.node && lhs.sn == rhs.sn; }
+   template<typename Key, typename Val, typename Ord, typename LRetVal, typename RRetVal> inline bool
+      operator!=(bdict_iterator<Key, Val, Ord, LRetVal> lhs, bdict_iterator<Key, Val, Ord, RRetVal> rhs) noexcept { return !(lhs == rhs); }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::iterator
+      bdict<Key, Val, Ord>::find(const key_type &key) {
+      for (auto root = bdict::root; root;) {
+         bool found; auto sn = search(root, key, found);
+         if (found) return {this, root, sn};
+         if (root->leaf) break;
+         root = child(root, sn);
+      }
+      return end();
+   }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_iterator
+      bdict<Key, Val, Ord>::find(const key_type &key) const { return const_cast<bdict *>(this)->find(key); }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::iterator
+      bdict<Key, Val, Ord>::begin() noexcept { return {this, find_most<left>()}; }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::iterator
+      bdict<Key, Val, Ord>::end()   noexcept { return {this, {}}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_iterator
+      bdict<Key, Val, Ord>::begin() const noexcept { return {this, find_most<left>()}; }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_iterator
+      bdict<Key, Val, Ord>::end()   const noexcept { return {this, {}}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::reverse_iterator
+      bdict<Key, Val, Ord>::rbegin() noexcept { return reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::reverse_iterator
+      bdict<Key, Val, Ord>::rend()   noexcept { return reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_reverse_iterator
+      bdict<Key, Val, Ord>::rbegin() const noexcept { return const_reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_reverse_iterator
+      bdict<Key, Val, Ord>::rend()   const noexcept { return const_reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_iterator
+      bdict<Key, Val, Ord>::cbegin() const noexcept { return begin(); }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_iterator
+      bdict<Key, Val, Ord>::cend()   const noexcept { return end(); }
+
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_reverse_iterator
+      bdict<Key, Val, Ord>::crbegin() const noexcept { return rbegin(); }
+   template<typename Key, typename Val, typename Ord> inline typename bdict<Key, Val, Ord>::const_reverse_iterator
+      bdict<Key, Val, Ord>::crend()   const noexcept { return rend(); }
+} // namespace aux
+
+} // namespace MNL_AUX_UUID
+
+# endif // # ifndef MNL_INCLUDED_BDICT
@@ -100,6 +100,9 @@ namespace aux { namespace pub {
          { set(make_pair((move)(key), Val{})); }
       void unset(const Key &key)
          { set_root(remove(root, key)); if (!most[left]) most[left] = find_most<left>(); else if (!most[right]) most[right] = find_most<right>(); }
+      // replaces the content by size entries moved out of [first, ...) in O(size), provided they are in strictly ascending order:
+      template<typename InIt> void assign_sorted(InIt first, size_type size)
+         { auto root = build(first, size); clear(), set_root(root), count = size; most[left] = find_most<left>(), most[right] = find_most<right>(); }
    public: // Strictly conforming to STL associative containers
       iterator find(const key_type &);
       const_iterator find(const key_type &) const;
@@ -139,6 +142,7 @@ namespace aux { namespace pub {
       node *find(node *, const Key &) const;
       static node *clone(node *);
       static void dispose(node *) noexcept;
+      template<typename InIt> static node *build(InIt &, size_type);
       template<bool> node *find_most();
    public: // Strictly conforming to STL containers
       bool empty() const noexcept { return !size(); }
@@ -239,6 +243,15 @@ namespace aux { namespace pub {
    template<typename Key, typename Val, typename Ord> void dict<Key, Val, Ord>::dispose(node *root) noexcept {
       if (root) dispose(root->child[left]), dispose(root->child[right]), delete root;
    }
+   template<typename Key, typename Val, typename Ord>
+   template<typename InIt> typename dict<Key, Val, Ord>::node *dict<Key, Val, Ord>::build(InIt &first, size_type size) { // perfectly balanced
+      if (!size) return {};
+      auto lhs = build(first, size / 2), res = (node *){};
+      try { res = new node{{move(first->first), move(first->second)}, {}, height(lhs) + 1}; } catch (...) { dispose(lhs), throw; }
+      ++first, set_child<left>(res, lhs);
+      try { set_child<right>(res, build(first, size - size / 2 - 1)); } catch (...) { dispose(res), throw; }
+      return res;
+   }
    template<typename Key, typename Val, typename Ord> template<bool dir> inline typename dict<Key, Val, Ord>::node *dict<Key, Val, Ord>::find_most() {
       if (!root) return {};
       auto res = root;
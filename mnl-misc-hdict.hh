@@ -0,0 +1,285 @@
+// mnl-misc-hdict.hh -- hash-table dictionary ADT (unordered counterpart of dict)
+
+/*    Copyright (C) 2018, 2019, 2020 Alexey Protasov (AKA Alex or rusini)
+
+   This file is part of MANOOL.
+
+   MANOOL is free software: you can redistribute it and/or modify it under the terms of the version 3 of the GNU General Public License
+   as published by the Free Software Foundation (and only version 3).
+
+   MANOOL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with MANOOL.  If not, see <https://www.gnu.org/licenses/>.  */
+
+
+# ifndef MNL_INCLUDED_HDICT
+# define MNL_INCLUDED_HDICT
+
+# include <new>         // placement new
+# include <type_traits> // aligned_storage, is_nothrow_move_constructible
+# include <functional>  // hash
+# include "mnl-misc-dict.hh"
+
+namespace MNL_AUX_UUID {
+
+namespace aux {
+   // hash falls back to std::hash and equal to operator== unless overloaded:
+   template<typename Key> inline size_t hash(const Key &key) noexcept(noexcept(std::hash<Key>{}(key)))
+      { return std::hash<Key>{}(key); }
+   template<typename Key> struct default_hash
+      { auto operator()(const Key &key) const noexcept(noexcept(hash(key)))->decltype(hash(key)) { return hash(key); } };
+   template<typename Key> inline bool equal(const Key &lhs, const Key &rhs) noexcept(noexcept(lhs == rhs))
+      { return lhs == rhs; }
+   template<typename Key> struct default_equal
+      { auto operator()(const Key &lhs, const Key &rhs) const noexcept(noexcept(equal(lhs, rhs)))->decltype(equal(lhs, rhs)) { return equal(lhs, rhs); } };
+   template<typename Key, typename Val, typename Hash, typename Eq, typename RetVal> class hdict_iterator;
+} // namespace aux
+
+namespace aux { namespace pub {
+   // Same interface and guarantees as dict (except for the iteration order, which is unspecified), but with expected O(1) lookups:
+   // open addressing with linear probing and backward-shift deletion, where hash values are cached, so that Hash is called once per operation,
+   // and all restructuring is done without calling Hash or Eq (note that iterators are invalidated by any modification, unlike for dict):
+   template<typename Key, typename Val = dict_val_empty, typename Hash = default_hash<Key>, typename Eq = default_equal<Key>> class hdict {
+      static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value,
+         "std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value");
+   public: // Typedefs mostly conforming to STL unordered associative containers (most are unused in MANOOL) - no allocator_type
+      typedef Key                                                   key_type;
+      typedef Val                                                   mapped_type;
+      typedef pair<const key_type, mapped_type>                     value_type;
+      typedef Hash                                                  hasher;
+      typedef Eq                                                    key_equal;
+      typedef value_type                                            &reference;
+      typedef const value_type                                      &const_reference;
+      typedef hdict_iterator<Key, Val, Hash, Eq, value_type>        iterator;
+      typedef hdict_iterator<Key, Val, Hash, Eq, const value_type>  const_iterator;
+      typedef size_t                                                size_type;
+      typedef ptrdiff_t                                             difference_type;
+      typedef value_type                                            *pointer;
+      typedef const value_type                                      *const_pointer;
+      typedef std::reverse_iterator<iterator>                       reverse_iterator;
+      typedef std::reverse_iterator<const_iterator>                 const_reverse_iterator;
+   public: // Standard operations
+      hdict() = default;
+   public:
+      hdict(const hdict &rhs): hash(rhs.hash), eq(rhs.eq), slots(clone(rhs.slots, rhs.mask)), mask(rhs.mask), count(rhs.count) {}
+      hdict(hdict &&rhs): hash((move)(rhs.hash)), eq((move)(rhs.eq)), slots(rhs.slots), mask(rhs.mask), count(rhs.count) {
+         rhs.slots = {}; rhs.mask = {}; rhs.count = {}; // left in an indeterminate but completely consistent state, as in STL
+      }
+      hdict &operator=(const hdict &rhs) {
+         if (&rhs != this) {
+            auto slots = clone(rhs.slots, rhs.mask); try { hash = rhs.hash, eq = rhs.eq; } catch (...) { dispose(slots, rhs.mask), throw; }
+            (dispose(hdict::slots, mask), hdict::slots) = slots; mask = rhs.mask, count = rhs.count;
+         }
+         return *this;
+      }
+      hdict &operator=(hdict &&rhs) {
+         swap(rhs);
+         return *this;
+      }
+      ~hdict() {
+         dispose(slots, mask);
+      }
+      void swap(hdict &rhs) {
+         using std::swap; swap(hash, rhs.hash); swap(eq, rhs.eq); swap(slots, rhs.slots); swap(mask, rhs.mask); swap(count, rhs.count);
+      }
+   public: // Dict-specific operations
+      explicit hdict(Hash hash, Eq eq = {})
+         : hash((move)(hash)), eq((move)(eq)) {}
+      void set(pair<Key, Val> data)
+         { insert(move(data)); }
+      void set(Key key, Val val)
+         { set(make_pair((move)(key), (move)(val))); }
+      void set(Key key)
+         { set(make_pair((move)(key), Val{})); }
+      void unset(const Key &key)
+         { remove(key); }
+   public: // Strictly conforming to STL associative containers
+      iterator find(const key_type &);
+      const_iterator find(const key_type &) const;
+      iterator begin() noexcept, end() noexcept;
+      const_iterator begin() const noexcept, end() const noexcept;
+      reverse_iterator rbegin() noexcept, rend() noexcept;
+      const_reverse_iterator rbegin() const noexcept, rend() const noexcept;
+      const_iterator cbegin() const noexcept, cend() const noexcept;
+      const_reverse_iterator crbegin() const noexcept, crend() const noexcept;
+   public: // Mostly conforming to STL unordered associative containers
+      Hash hash_function() const { return hash; }
+      Eq key_eq() const { return eq; }
+      Val &operator[](const Key &key) { return find(key)->second; }
+      const Val &operator[](const Key & key) const { return find(key)->second; }
+      void reserve(size_type);
+   private: // Concrete representation
+      Hash hash = {};
+      Eq eq = {};
+      struct slot;
+      slot *slots = {}; // mask + 1 slots followed by a sentinel, or null when nothing has been allocated yet
+      size_type mask = {}, count = {};
+      friend iterator;
+      friend const_iterator;
+   private: // Open addressing helpers
+      static size_t cached(size_t key) noexcept { return key + !key; } // 0 marks a free slot
+      static slot *new_slots(size_type mask);
+      void place(size_t key, pair<Key, Val> &&) noexcept;
+      void rehash(size_type mask);
+      void erase(size_type) noexcept;
+      size_type search(size_t key, const Key &) const;
+      void insert(pair<Key, Val> &&);
+      void remove(const Key &);
+      static slot *clone(const slot *, size_type mask);
+      static void dispose(slot *, size_type mask) noexcept;
+   public: // Strictly conforming to STL containers
+      bool empty() const noexcept { return !size(); }
+      size_type size() const noexcept { return count; }
+      size_type max_size() const noexcept { return size_type(-1) / sizeof(slot); }
+      void clear() noexcept { (dispose(slots, mask), slots) = {}; mask = {}, count = {}; }
+   };
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void swap(hdict<Key, Val, Hash, Eq> &lhs, hdict<Key, Val, Hash, Eq> &rhs)
+      { lhs.swap(rhs); }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> struct hdict<Key, Val, Hash, Eq>::slot {
+      size_t key; // cached hash
+      typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type data;
+      value_type &operator*() noexcept { return reinterpret_cast<value_type &>(data); }
+      const value_type &operator*() const noexcept { return reinterpret_cast<const value_type &>(data); }
+   };
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::slot *
+      hdict<Key, Val, Hash, Eq>::new_slots(size_type mask) {
+      auto res = new slot[mask + 2];
+      for (size_type sn = 0; sn <= mask; ++sn) res[sn].key = 0;
+      return res[mask + 1].key = 1, res;
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::place(size_t key, pair<Key, Val> &&data) noexcept {
+      auto sn = key & mask; while (slots[sn].key) sn = sn + 1 & mask;
+      new (&slots[sn].data) value_type((move)(data)), slots[sn].key = key;
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::rehash(size_type mask) {
+      auto slots = new_slots(mask);
+      std::swap(hdict::slots, slots), std::swap(hdict::mask, mask);
+      if (slots) {
+         // moving out of a const Key that is about to be destroyed anyway (as std::map node extraction does)
+         for (size_type sn = 0; sn <= mask; ++sn) if (slots[sn].key)
+            place(slots[sn].key, make_pair((move)(const_cast<Key &>((*slots[sn]).first)), (move)((*slots[sn]).second))), (*slots[sn]).~value_type();
+         delete[] slots;
+      }
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::erase(size_type sn) noexcept {
+      (*slots[sn]).~value_type();
+      for (auto next = sn + 1 & mask; slots[next].key; next = next + 1 & mask)
+      if ((next - slots[next].key & mask) >= (next - sn & mask)) { // the hole is on the probe path of the entry
+         new (&slots[sn].data) value_type((move)(const_cast<Key &>((*slots[next]).first)), (move)((*slots[next]).second)), (*slots[next]).~value_type();
+         slots[sn].key = slots[next].key, sn = next;
+      }
+      slots[sn].key = 0, --count;
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::size_type
+      hdict<Key, Val, Hash, Eq>::search(size_t key, const Key &data) const { // may call eq
+      for (auto sn = key & mask;; sn = sn + 1 & mask) {
+         if (!slots[sn].key) return mask + 1;
+         if (slots[sn].key == key && eq(data, (*slots[sn]).first)) return sn;
+      }
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::insert(pair<Key, Val> &&data) {
+      auto key = cached(hash(data.first));
+      if (count) { auto sn = search(key, data.first); if (sn <= mask) { (*slots[sn]).second = (move)(data.second); return; } }
+      if ((count + 1) * 4 > (mask + 1) * 3) rehash(slots ? mask * 2 + 1 : 15); // load factor up to 3/4
+      place(key, move(data)), ++count;
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::remove(const Key &data) {
+      if (!count) return;
+      auto sn = search(cached(hash(data)), data); if (sn <= mask) erase(sn);
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::reserve(size_type size) {
+      auto mask = slots ? hdict::mask : 15; while ((size + 1) * 4 > (mask + 1) * 3) mask = mask * 2 + 1;
+      if (!slots || mask != hdict::mask) rehash(mask);
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::slot *
+      hdict<Key, Val, Hash, Eq>::clone(const slot *slots, size_type mask) {
+      if (!slots) return {};
+      auto res = new_slots(mask); size_type sn = 0;
+      try {
+         for (; sn <= mask; ++sn) if (slots[sn].key) new (&res[sn].data) value_type(*slots[sn]), res[sn].key = slots[sn].key;
+      } catch (...) {
+         while (sn) if (res[--sn].key) (*res[sn]).~value_type();
+         delete[] res; throw;
+      }
+      return res;
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline void hdict<Key, Val, Hash, Eq>::dispose(slot *slots, size_type mask) noexcept {
+      if (!slots) return;
+      for (size_type sn = 0; sn <= mask; ++sn) if (slots[sn].key) (*slots[sn]).~value_type();
+      delete[] slots;
+   }
+}} // namespace aux::pub
+
+// Iterators ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux {
+   template<typename Key, typename Val, typename Hash, typename Eq, typename IterVal>
+   class hdict_iterator: public std::iterator<std::bidirectional_iterator_tag, IterVal> { // Strictly conforming to STL bidirectional iterators
+   public: // Standard operations
+      hdict_iterator() = default;
+      template<typename Key_, typename Val_, typename Hash_, typename Eq_, typename LRetVal_, typename RRetVal_> friend bool
+         operator==(hdict_iterator<Key_, Val_, Hash_, Eq_, LRetVal_>, hdict_iterator<Key_, Val_, Hash_, Eq_, RRetVal_>) noexcept;
+      template<typename Key_, typename Val_, typename Hash_, typename Eq_, typename LRetVal_, typename RRetVal_> friend bool
+         operator!=(hdict_iterator<Key_, Val_, Hash_, Eq_, LRetVal_>, hdict_iterator<Key_, Val_, Hash_, Eq_, RRetVal_>) noexcept;
+   public: // Conforming to STL
+      IterVal &operator*() const noexcept { return **slot; }
+      IterVal *operator->() const noexcept { return &*(*this); }
+      hdict_iterator &operator++() noexcept { while (!(++slot)->key); return *this; } // stops at the sentinel
+      hdict_iterator &operator--() noexcept { while (!(--slot)->key); return *this; }
+      hdict_iterator operator++(int) noexcept { auto res = *this; ++(*this); return res; }
+      hdict_iterator operator--(int) noexcept { auto res = *this; --(*this); return res; }
+      operator hdict_iterator<Key, Val, Hash, Eq, const IterVal>() const noexcept { return {slot}; }
+   private: // Concrete representation
+      typename hdict<Key, Val, Hash, Eq>::slot *slot;
+      hdict_iterator(decltype(slot) slot) noexcept: slot(slot) {}
+      friend class hdict<Key, Val, Hash, Eq>;
+      friend class hdict_iterator<Key, Val, Hash, Eq, typename std::remove_const<IterVal>::type>;
+   };
+   template<typename Key, typename Val, typename Hash, typename Eq, typename LRetVal, typename RRetVal> inline bool
+      operator==(hdict_iterator<Key, Val, Hash, Eq, LRetVal> lhs, hdict_iterator<Key, Val, Hash, Eq, RRetVal> rhs) noexcept { return lhs.slot == rhs.slot; }
+   template<typename Key, typename Val, typename Hash, typename Eq, typename LRetVal, typename RRetVal> inline bool
+      operator!=(hdict_iterator<Key, Val, Hash, Eq, LRetVal> lhs, hdict_iterator<Key, Val, Hash, Eq, RRetVal> rhs) noexcept { return !(lhs == rhs); }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::iterator
+      hdict<Key, Val, Hash, Eq>::find(const key_type &key) {
+      if (!count) return end();
+      return {slots + search(cached(hash(key)), key)}; // the sentinel is at end()
+   }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_iterator
+      hdict<Key, Val, Hash, Eq>::find(const key_type &key) const { return const_cast<hdict *>(this)->find(key); }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::iterator
+      hdict<Key, Val, Hash, Eq>::begin() noexcept { if (!count) return end(); auto res = slots; while (!res->key) ++res; return {res}; }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::iterator
+      hdict<Key, Val, Hash, Eq>::end()   noexcept { return {slots ? slots + mask + 1 : slots}; }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_iterator
+      hdict<Key, Val, Hash, Eq>::begin() const noexcept { return const_cast<hdict *>(this)->begin(); }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_iterator
+      hdict<Key, Val, Hash, Eq>::end()   const noexcept { return const_cast<hdict *>(this)->end(); }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::reverse_iterator
+      hdict<Key, Val, Hash, Eq>::rbegin() noexcept { return reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::reverse_iterator
+      hdict<Key, Val, Hash, Eq>::rend()   noexcept { return reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_reverse_iterator
+      hdict<Key, Val, Hash, Eq>::rbegin() const noexcept { return const_reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_reverse_iterator
+      hdict<Key, Val, Hash, Eq>::rend()   const noexcept { return const_reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_iterator
+      hdict<Key, Val, Hash, Eq>::cbegin() const noexcept { return begin(); }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_iterator
+      hdict<Key, Val, Hash, Eq>::cend()   const noexcept { return end(); }
+
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_reverse_iterator
+      hdict<Key, Val, Hash, Eq>::crbegin() const noexcept { return rbegin(); }
+   template<typename Key, typename Val, typename Hash, typename Eq> inline typename hdict<Key, Val, Hash, Eq>::const_reverse_iterator
+      hdict<Key, Val, Hash, Eq>::crend()   const noexcept { return rend(); }
+} // namespace aux
+
+} // namespace MNL_AUX_UUID
+
+# endif // # ifndef MNL_INCLUDED_HDICT
@@ -31,6 +31,13 @@ namespace aux {
 namespace aux { namespace pub {
    void stk_limit(long long) noexcept, heap_limit(long long) noexcept /*NOT MT-safe!*/; // precond: size >= 0, size < 1ll << 47
    long long stk_reserve(long long) noexcept, heap_reserve(long long) noexcept;         // ditto
+   long long heap_slack(long long) noexcept; // per-thread heap accounting slack (in effect only in multithreaded builds); precond: size >= 0
+   struct heap_statistics {
+      long long current, peak;          // bytes accounted for in the heap limit (including unused slab space and per-thread credit)
+      long long alloc_count, free_count; // since process start
+      struct { long long max_size, alloc_count, free_count; } size_class[17]; // in ascending order of size; the last one is for large blocks
+   };
+   heap_statistics heap_stats() noexcept; // counts are approximate while other threads are running
    MNL_INLINE inline void stk_check() { unsigned long _; if (MNL_UNLIKELY(reinterpret_cast<long long>(&_) < stk_lim)) err_stk_overflow(); }
    class stack_overflow: public std::exception { const char *what() const noexcept override; };
    class heap_exhausted: public std::bad_alloc { const char *what() const noexcept override; };
@@ -0,0 +1,466 @@
+// mnl-misc-pdict.hh -- persistent B-tree variant of the dictionary ADT (see mnl-misc-dict.hh and mnl-misc-bdict.hh)
+
+/*    Copyright (C) 2018, 2019, 2020 Alexey Protasov (AKA Alex or rusini)
+
+   This file is part of MANOOL.
+
+   MANOOL is free software: you can redistribute it and/or modify it under the terms of the version 3 of the GNU General Public License
+   as published by the Free Software Foundation (and only version 3).
+
+   MANOOL is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along with MANOOL.  If not, see <https://www.gnu.org/licenses/>.  */
+
+
+# ifndef MNL_INCLUDED_PDICT
+# define MNL_INCLUDED_PDICT
+
+# include <new>         // placement new
+# include <type_traits> // aligned_storage, is_nothrow_move_constructible
+# include "mnl-misc-dict.hh"
+
+namespace MNL_AUX_UUID {
+
+namespace aux {
+   template<typename Key, typename Val, typename Ord, typename RetVal> class pdict_iterator;
+} // namespace aux
+
+namespace aux { namespace pub {
+   // Same interface and guarantees as bdict, but copying takes O(1) time: nodes are reference-counted and shared among copies, and a modification
+   // copies only the shared nodes on its path (path copying). Hence, mapped values may be modified only through iterators obtained from non-const find
+   // (for the entry found) or non-const begin (for the whole traversal), which unshare the respective nodes first:
+   template<typename Key, typename Val = dict_val_empty, typename Ord = default_order<Key>> class pdict {
+      static_assert(std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value,
+         "std::is_nothrow_move_constructible<Key>::value && std::is_nothrow_move_constructible<Val>::value");
+   public: // Typedefs mostly conforming to STL associative containers (most are unused in MANOOL) - no allocator_type
+      typedef Key                                             key_type;
+      typedef Val                                             mapped_type;
+      typedef pair<const key_type, mapped_type>               value_type;
+      typedef Ord                                             key_order; // dict-specific - instead of key_compare and value_compare
+      typedef value_type                                      &reference;
+      typedef const value_type                                &const_reference;
+      typedef pdict_iterator<Key, Val, Ord, value_type>       iterator;
+      typedef pdict_iterator<Key, Val, Ord, const value_type> const_iterator;
+      typedef size_t                                          size_type;
+      typedef ptrdiff_t                                       difference_type;
+      typedef value_type                                      *pointer;
+      typedef const value_type                                *const_pointer;
+      typedef std::reverse_iterator<iterator>                 reverse_iterator;
+      typedef std::reverse_iterator<const_iterator>           const_reverse_iterator;
+   public: // Standard operations
+      pdict() = default;
+   public:
+      pdict(const pdict &rhs): ord(rhs.ord), root(hold(rhs.root)), count(rhs.count) {}
+      pdict(pdict &&rhs): ord((move)(rhs.ord)), root(rhs.root), count(rhs.count) {
+         rhs.root = {}; rhs.count = {}; // left in an indeterminate but completely consistent state, as in STL
+      }
+      pdict &operator=(const pdict &rhs) {
+         if (&rhs != this) { ord = rhs.ord; auto root = hold(rhs.root); (release(pdict::root), pdict::root) = root; count = rhs.count; }
+         return *this;
+      }
+      pdict &operator=(pdict &&rhs) {
+         swap(rhs);
+         return *this;
+      }
+      ~pdict() {
+         release(root);
+      }
+      void swap(pdict &rhs) {
+         using std::swap; swap(ord, rhs.ord); swap(root, rhs.root); swap(count, rhs.count);
+      }
+   public: // Dict-specific operations
+      explicit pdict(Ord ord)
+         : ord((move)(ord)) {}
+      void set(pair<Key, Val> data)
+         { insert(move(data)); }
+      void set(Key key, Val val)
+         { set(make_pair((move)(key), (move)(val))); }
+      void set(Key key)
+         { set(make_pair((move)(key), Val{})); }
+      void unset(const Key &key)
+         { remove(key); }
+      template<typename InIt> void assign_sorted(InIt first, size_type size); // as for dict
+   public: // Strictly conforming to STL associative containers
+      iterator find(const key_type &);
+      const_iterator find(const key_type &) const;
+      iterator begin(), end() noexcept;
+      const_iterator begin() const noexcept, end() const noexcept;
+      reverse_iterator rbegin() noexcept, rend();
+      const_reverse_iterator rbegin() const noexcept, rend() const noexcept;
+      const_iterator cbegin() const noexcept, cend() const noexcept;
+      const_reverse_iterator crbegin() const noexcept, crend() const noexcept;
+   public: // Mostly conforming to STL associative containers
+      Ord key_ord() const { return ord; }
+      Val &operator[](const Key &key) { return find(key)->second; }
+      const Val &operator[](const Key & key) const { return find(key)->second; }
+   private: // Concrete representation
+      static const int min_count = 16, max_count = 2 * min_count + 1; // entries per node (except that the root may have less than min_count)
+      static const int max_height = sizeof(size_type) * 8 / 4 + 2; // a non-root inner node has more than 2^4 children
+      Ord ord = {};
+      struct node;
+      struct inner;
+      node *root = {};
+      size_type count = {};
+      static const auto left = false, right = true;
+      friend iterator;
+      friend const_iterator;
+   private: // B-tree helpers (as in bdict, except that every node is unshared before it is modified)
+      static node *&child(const node *, int) noexcept;
+      static node *new_node(bool leaf);
+      static void delete_node(node *) noexcept;
+      static node *hold(node *) noexcept;
+      static void release(node *) noexcept;
+      static node *own(node *&);
+      static void unshare(node *&);
+      static void move_entry(node *dst, int, node *src, int) noexcept;
+      static void insert_entry(node *, int, pair<Key, Val> &&, node *child = {}) noexcept;
+      static void erase_entry(node *, int) noexcept;
+      static void split(node *, int, node *) noexcept;
+      static void merge(node *, int) noexcept;
+      static int fill(node *, int);
+      template<bool> static pair<Key, Val> remove_most(node *);
+      static void remove_at(node *, int);
+      void shrink() noexcept;
+      int search(const node *, const Key &, bool &found) const;
+      void insert(pair<Key, Val> &&);
+      void remove(const Key &);
+      template<bool, typename Iter> void locate(Iter &, const Key &);
+      template<bool, typename Iter> void find_most(Iter &) const noexcept;
+      struct level { size_type base, rem, index; }; // layout of a level for assign_sorted
+      template<typename InIt> static node *build(InIt &, level [], int);
+   public: // Strictly conforming to STL containers
+      bool empty() const noexcept { return !size(); }
+      size_type size() const noexcept { return count; }
+      size_type max_size() const noexcept { return size_type(-1) / sizeof(value_type); }
+      void clear() noexcept { (release(root), root) = {}; count = {}; }
+   };
+   template<typename Key, typename Val, typename Ord> inline void swap(pdict<Key, Val, Ord> &lhs, pdict<Key, Val, Ord> &rhs)
+      { lhs.swap(rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator==(const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin()); }
+   template<typename Key, typename Val, typename Ord> inline bool operator< (const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+   template<typename Key, typename Val, typename Ord> inline bool operator!=(const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator!=(lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator> (const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator> (lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator<=(const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator<=(lhs, rhs); }
+   template<typename Key, typename Val, typename Ord> inline bool operator>=(const pdict<Key, Val, Ord> &lhs, const pdict<Key, Val, Ord> &rhs)
+      { return std::rel_ops::operator>=(lhs, rhs); }
+
+   template<typename Key, typename Val, typename Ord> struct pdict<Key, Val, Ord>::node {
+      /*atomic*/ long rc;
+      int  size; bool leaf;
+      typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type data[max_count];
+      value_type &operator[](int sn) noexcept { return reinterpret_cast<value_type &>(data[sn]); }
+      const value_type &operator[](int sn) const noexcept { return reinterpret_cast<const value_type &>(data[sn]); }
+   };
+   template<typename Key, typename Val, typename Ord> struct pdict<Key, Val, Ord>::inner: node {
+      node *child[max_count + 1];
+   };
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::node *&pdict<Key, Val, Ord>::child(const node *root, int sn) noexcept {
+      return static_cast<inner *>(const_cast<node *>(root))->child[sn];
+   }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::node *pdict<Key, Val, Ord>::new_node(bool leaf) {
+      node *res = leaf ? new node : new inner;
+      return res->rc = 1, res->size = 0, res->leaf = leaf, res;
+   }
+   template<typename Key, typename Val, typename Ord> inline void pdict<Key, Val, Ord>::delete_node(node *root) noexcept {
+      if (root->leaf) delete root; else delete static_cast<inner *>(root);
+   }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::node *pdict<Key, Val, Ord>::hold(node *root) noexcept {
+      if (root) MNL_IF_WITHOUT_MT(++root->rc) MNL_IF_WITH_MT(__atomic_add_fetch(&root->rc, 1, __ATOMIC_RELAXED));
+      return root;
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::release(node *root) noexcept {
+      if (!root || MNL_IF_WITHOUT_MT(--root->rc) MNL_IF_WITH_MT(__atomic_sub_fetch(&root->rc, 1, __ATOMIC_ACQ_REL))) return;
+      if (!root->leaf) for (int sn = 0; sn <= root->size; ++sn) release(child(root, sn));
+      for (int sn = 0; sn < root->size; ++sn) (*root)[sn].~value_type();
+      delete_node(root);
+   }
+   template<typename Key, typename Val, typename Ord> typename pdict<Key, Val, Ord>::node *pdict<Key, Val, Ord>::own(node *&root) { // unshares (a single node)
+      if (MNL_LIKELY(MNL_IF_WITHOUT_MT(root->rc) MNL_IF_WITH_MT(__atomic_load_n(&root->rc, __ATOMIC_ACQUIRE)) == 1)) return root;
+      auto res = new_node(root->leaf);
+      try {
+         for (; res->size < root->size; ++res->size) new (&res->data[res->size]) value_type((*root)[res->size]);
+      } catch (...) {
+         for (; res->size; --res->size) (*res)[res->size - 1].~value_type();
+         delete_node(res); throw;
+      }
+      if (!res->leaf) for (int sn = 0; sn <= res->size; ++sn) child(res, sn) = hold(child(root, sn));
+      return release(root), root = res;
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::unshare(node *&root) { // unshares (a whole subtree)
+      if (root && !own(root)->leaf) for (int sn = 0; sn <= root->size; ++sn) unshare(child(root, sn));
+   }
+   template<typename Key, typename Val, typename Ord> inline void pdict<Key, Val, Ord>::move_entry(node *dst, int dst_sn, node *src, int src_sn) noexcept {
+      // moving out of a const Key that is about to be destroyed anyway (as std::map node extraction does)
+      new (&dst->data[dst_sn]) value_type(move(const_cast<Key &>((*src)[src_sn].first)), move((*src)[src_sn].second)), (*src)[src_sn].~value_type();
+   }
+   template<typename Key, typename Val, typename Ord>
+   void pdict<Key, Val, Ord>::insert_entry(node *root, int sn, pair<Key, Val> &&data, node *right_child) noexcept { // precond: root->size < max_count
+      for (int dst = root->size; dst > sn; --dst) move_entry(root, dst, root, dst - 1);
+      new (&root->data[sn]) value_type(move(data.first), move(data.second));
+      if (!root->leaf) {
+         for (int dst = root->size + 1; dst > sn + 1; --dst) child(root, dst) = child(root, dst - 1);
+         child(root, sn + 1) = right_child;
+      }
+      ++root->size;
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::erase_entry(node *root, int sn) noexcept { // precond: root->leaf
+      (*root)[sn].~value_type();
+      for (int dst = sn; dst < root->size - 1; ++dst) move_entry(root, dst, root, dst + 1);
+      --root->size;
+   }
+   template<typename Key, typename Val, typename Ord>
+   void pdict<Key, Val, Ord>::split(node *root, int sn, node *res) noexcept { // precond: child(root, sn)->size == max_count and unshared, res is empty and of the same kind
+      auto lhs = child(root, sn);
+      for (int src = min_count + 1; src < max_count; ++src) move_entry(res, src - (min_count + 1), lhs, src);
+      if (!lhs->leaf) for (int src = min_count + 1; src <= max_count; ++src) child(res, src - (min_count + 1)) = child(lhs, src);
+      pair<Key, Val> median{move(const_cast<Key &>((*lhs)[min_count].first)), move((*lhs)[min_count].second)};
+      (*lhs)[min_count].~value_type(), lhs->size = res->size = min_count;
+      insert_entry(root, sn, move(median), res);
+   }
+   template<typename Key, typename Val, typename Ord>
+   void pdict<Key, Val, Ord>::merge(node *root, int sn) noexcept { // precond: both children have min_count entries at most and are unshared
+      auto lhs = child(root, sn), rhs = child(root, sn + 1);
+      move_entry(lhs, lhs->size, root, sn);
+      for (int src = 0; src < rhs->size; ++src) move_entry(lhs, lhs->size + 1 + src, rhs, src);
+      if (!lhs->leaf) for (int src = 0; src <= rhs->size; ++src) child(lhs, lhs->size + 1 + src) = child(rhs, src);
+      lhs->size += rhs->size + 1;
+      for (int dst = sn; dst < root->size - 1; ++dst) move_entry(root, dst, root, dst + 1);
+      for (int dst = sn + 1; dst < root->size; ++dst) child(root, dst) = child(root, dst + 1);
+      --root->size;
+      rhs->size = 0, delete_node(rhs);
+   }
+   template<typename Key, typename Val, typename Ord>
+   int pdict<Key, Val, Ord>::fill(node *root, int sn) { // ensures the child to descend into has more than min_count entries (and is unshared)
+      auto target = own(child(root, sn));
+      if (target->size > min_count) return sn;
+      if (sn > 0 && child(root, sn - 1)->size > min_count) { // borrow from the left sibling
+         auto lhs = own(child(root, sn - 1));
+         for (int dst = target->size; dst > 0; --dst) move_entry(target, dst, target, dst - 1);
+         move_entry(target, 0, root, sn - 1), move_entry(root, sn - 1, lhs, lhs->size - 1);
+         if (!target->leaf) {
+            for (int dst = target->size + 1; dst > 0; --dst) child(target, dst) = child(target, dst - 1);
+            child(target, 0) = child(lhs, lhs->size);
+         }
+         ++target->size, --lhs->size;
+         return sn;
+      }
+      if (sn < root->size && child(root, sn + 1)->size > min_count) { // borrow from the right sibling
+         auto rhs = own(child(root, sn + 1));
+         move_entry(target, target->size, root, sn), move_entry(root, sn, rhs, 0);
+         for (int dst = 0; dst < rhs->size - 1; ++dst) move_entry(rhs, dst, rhs, dst + 1);
+         if (!target->leaf) {
+            child(target, target->size + 1) = child(rhs, 0);
+            for (int dst = 0; dst < rhs->size; ++dst) child(rhs, dst) = child(rhs, dst + 1);
+         }
+         ++target->size, --rhs->size;
+         return sn;
+      }
+      if (sn < root->size) return own(child(root, sn + 1)), merge(root, sn), sn;
+      return own(child(root, sn - 1)), merge(root, sn - 1), sn - 1;
+   }
+   template<typename Key, typename Val, typename Ord>
+   template<bool dir> pair<Key, Val> pdict<Key, Val, Ord>::remove_most(node *root) { // precond: root->size > min_count and root is unshared
+      while (!root->leaf) root = child(root, fill(root, dir ? root->size : 0));
+      auto sn = dir ? root->size - 1 : 0;
+      pair<Key, Val> res{move(const_cast<Key &>((*root)[sn].first)), move((*root)[sn].second)};
+      return erase_entry(root, sn), res;
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::remove_at(node *root, int sn) { // precond: root is unshared
+      for (;;) {
+         if (root->leaf) return erase_entry(root, sn);
+         if (child(root, sn)->size > min_count || child(root, sn + 1)->size > min_count) {
+            auto data = child(root, sn)->size > min_count ? remove_most<right>(own(child(root, sn))) : remove_most<left>(own(child(root, sn + 1)));
+            (*root)[sn].~value_type(), new (&root->data[sn]) value_type(move(data.first), move(data.second));
+            return;
+         }
+         own(child(root, sn)), own(child(root, sn + 1)), merge(root, sn), root = child(root, sn), sn = min_count;
+      }
+   }
+   template<typename Key, typename Val, typename Ord> inline void pdict<Key, Val, Ord>::shrink() noexcept { // precond: root is unshared
+      if (root->size) return;
+      auto res = root->leaf ? nullptr : child(root, 0);
+      delete_node(root), root = res;
+   }
+   template<typename Key, typename Val, typename Ord> int pdict<Key, Val, Ord>::search(const node *root, const Key &key, bool &found) const {
+      int lo = 0, hi = root->size;
+      while (lo < hi) { // whatever ord returns, the result is in [0, root->size]
+         auto mid = (lo + hi) / 2; auto ord = pdict::ord(key, (*root)[mid].first);
+         if (ord < 0) hi = mid; else if (ord > 0) lo = mid + 1; else return found = true, mid;
+      }
+      return found = false, lo;
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::insert(pair<Key, Val> &&data) {
+      if (!root) root = new_node(true);
+      else if (own(root)->size == max_count) {
+         auto res = new_node(false), rhs = (node *){};
+         try { rhs = new_node(root->leaf); } catch (...) { delete_node(res); throw; }
+         child(res, 0) = root, root = res, split(root, 0, rhs);
+      }
+      for (auto root = pdict::root;;) {
+         bool found; auto sn = search(root, data.first, found);
+         if (found) return (*root)[sn].second = (move)(data.second), void();
+         if (root->leaf) return insert_entry(root, sn, move(data)), ++count, void();
+         if (own(child(root, sn))->size == max_count) {
+            split(root, sn, new_node(child(root, sn)->leaf));
+            auto ord = pdict::ord(data.first, (*root)[sn].first);
+            if (!ord) return (*root)[sn].second = (move)(data.second), void();
+            if (ord > 0) ++sn;
+         }
+         root = child(root, sn);
+      }
+   }
+   template<typename Key, typename Val, typename Ord> void pdict<Key, Val, Ord>::remove(const Key &key) {
+      if (!root) return;
+      for (auto root = own(pdict::root);;) {
+         bool found; auto sn = search(root, key, found);
+         if (found) return remove_at(root, sn), --count, shrink();
+         if (root->leaf) return;
+         sn = fill(root, sn);
+         if (root == pdict::root && !root->size) shrink(), root = pdict::root; else root = child(root, sn);
+      }
+   }
+   template<typename Key, typename Val, typename Ord> template<typename InIt> void pdict<Key, Val, Ord>::assign_sorted(InIt first, size_type size) {
+      level levels[max_height]; int height = 0; // see bdict::assign_sorted
+      for (auto entries = size; entries;) {
+         auto nodes = (entries + 1 + max_count) / (max_count + 1);
+         levels[height++] = {(entries - (nodes - 1)) / nodes, (entries - (nodes - 1)) % nodes, 0}, entries = nodes - 1;
+      }
+      auto root = height ? build(first, levels, height - 1) : nullptr;
+      clear(), pdict::root = root, count = size;
+   }
+   template<typename Key, typename Val, typename Ord>
+   template<typename InIt> typename pdict<Key, Val, Ord>::node *pdict<Key, Val, Ord>::build(InIt &first, level levels[], int height) { // in-order traversal
+      auto res = new_node(!height);
+      auto size = int(levels[height].base + (levels[height].index < levels[height].rem)); ++levels[height].index;
+      try {
+         for (;; ++first, ++res->size) {
+            if (height) child(res, res->size) = build(first, levels, height - 1);
+            if (res->size == size) break;
+            new (&res->data[res->size]) value_type(move(first->first), move(first->second));
+         }
+      } catch (...) {
+         for (int sn = 0; sn < res->size; ++sn) { if (height) release(child(res, sn)); (*res)[sn].~value_type(); }
+         delete_node(res); throw;
+      }
+      return res;
+   }
+}} // namespace aux::pub
+
+// Iterators ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+namespace aux {
+   template<typename Key, typename Val, typename Ord, typename IterVal>
+   class pdict_iterator: public std::iterator<std::bidirectional_iterator_tag, IterVal> { // Strictly conforming to STL bidirectional iterators
+   public: // Standard operations
+      pdict_iterator() = default;
+      template<typename Key_, typename Val_, typename Ord_, typename LRetVal_, typename RRetVal_> friend bool
+         operator==(const pdict_iterator<Key_, Val_, Ord_, LRetVal_> &, const pdict_iterator<Key_, Val_, Ord_, RRetVal_> &) noexcept;
+      template<typename Key_, typename Val_, typename Ord_, typename LRetVal_, typename RRetVal_> friend bool
+         operator!=(const pdict_iterator<Key_, Val_, Ord_, LRetVal_> &, const pdict_iterator<Key_, Val_, Ord_, RRetVal_> &) noexcept;
+   public: // Conforming to STL
+      IterVal &operator*() const noexcept { return (*path[depth - 1])[pos[depth - 1]]; }
+      IterVal *operator->() const noexcept { return &*(*this); }
+      pdict_iterator &operator++() noexcept { goto_next<pdict<Key, Val, Ord>::right>(); return *this; }
+      pdict_iterator &operator--() noexcept {
+         if (depth) goto_next<pdict<Key, Val, Ord>::left>(); else owner->template find_most<pdict<Key, Val, Ord>::right>(*this);
+         return *this;
+      }
+      pdict_iterator operator++(int) noexcept { auto res = *this; ++(*this); return res; }
+      pdict_iterator operator--(int) noexcept { auto res = *this; --(*this); return res; }
+      operator pdict_iterator<Key, Val, Ord, const IterVal>() const noexcept {
+         pdict_iterator<Key, Val, Ord, const IterVal> res{owner};
+         for (; res.depth < depth; ++res.depth) res.path[res.depth] = path[res.depth], res.pos[res.depth] = pos[res.depth];
+         return res;
+      }
+   private: // Concrete representation (path from the root, where pos is the entry for the last node and the child for the others)
+      const pdict<Key, Val, Ord> *owner;
+      int depth;
+      typename pdict<Key, Val, Ord>::node *path[pdict<Key, Val, Ord>::max_height];
+      unsigned char pos[pdict<Key, Val, Ord>::max_height];
+      explicit pdict_iterator(decltype(owner) owner) noexcept: owner(owner), depth(0) {}
+      friend class pdict<Key, Val, Ord>;
+      friend class pdict_iterator<Key, Val, Ord, typename std::remove_const<IterVal>::type>;
+   private: // Implementation helpers
+      template<bool dir> void goto_next() noexcept {
+         auto node = path[depth - 1];
+         if (!node->leaf) {
+            pos[depth - 1] += dir, node = pdict<Key, Val, Ord>::child(node, pos[depth - 1]);
+            for (; !node->leaf; node = pdict<Key, Val, Ord>::child(node, dir ? 0 : node->size)) path[depth] = node, pos[depth++] = dir ? 0 : node->size;
+            path[depth] = node, pos[depth++] = dir ? 0 : node->size - 1;
+         } else if (dir ? ++pos[depth - 1] == node->size : pos[depth - 1]-- == 0) {
+            do --depth; while (depth && pos[depth - 1] == (dir ? path[depth - 1]->size : 0));
+            if (depth && !dir) --pos[depth - 1];
+         }
+      }
+   };
+   template<typename Key, typename Val, typename Ord, typename LRetVal, typename RRetVal> inline bool
+      operator==(const pdict_iterator<Key, Val, Ord, LRetVal> &lhs, const pdict_iterator<Key, Val, Ord, RRetVal> &rhs) noexcept
+      { return lhs.depth == rhs.depth && (!lhs.depth || lhs.path[lhs.depth - 1] == rhs.path[rhs.depth - 1] && lhs.pos[lhs.depth - 1] == rhs.pos[rhs.depth - 1]); }
+   template<typename Key, typename Val, typename Ord, typename LRetVal, typename RRetVal> inline bool
+      operator!=(const pdict_iterator<Key, Val, Ord, LRetVal> &lhs, const pdict_iterator<Key, Val, Ord, RRetVal> &rhs) noexcept { return !(lhs == rhs); }
+
+   template<typename Key, typename Val, typename Ord> template<bool mut, typename Iter> inline void
+      pdict<Key, Val, Ord>::locate(Iter &res, const Key &key) {
+      res.depth = 0;
+      for (auto ref = &root; *ref;) {
+         auto root = mut ? own(*ref) : *ref;
+         bool found; auto sn = search(root, key, found);
+         res.path[res.depth] = root, res.pos[res.depth++] = sn;
+         if (found) return;
+         if (root->leaf) break;
+         ref = &child(root, sn);
+      }
+      res.depth = 0;
+   }
+   template<typename Key, typename Val, typename Ord> template<bool dir, typename Iter> inline void
+      pdict<Key, Val, Ord>::find_most(Iter &res) const noexcept {
+      res.depth = 0; if (!root) return;
+      auto node = root;
+      for (; !node->leaf; node = child(node, dir ? node->size : 0)) res.path[res.depth] = node, res.pos[res.depth++] = dir ? node->size : 0;
+      res.path[res.depth] = node, res.pos[res.depth++] = dir ? node->size - 1 : 0;
+   }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::iterator
+      pdict<Key, Val, Ord>::find(const key_type &key) { iterator res{this}; locate<true>(res, key); return res; }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_iterator
+      pdict<Key, Val, Ord>::find(const key_type &key) const { const_iterator res{this}; const_cast<pdict *>(this)->locate<false>(res, key); return res; }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::iterator
+      pdict<Key, Val, Ord>::begin()          { unshare(root); iterator res{this}; find_most<left>(res); return res; }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::iterator
+      pdict<Key, Val, Ord>::end()   noexcept { return iterator{this}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_iterator
+      pdict<Key, Val, Ord>::begin() const noexcept { const_iterator res{this}; find_most<left>(res); return res; }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_iterator
+      pdict<Key, Val, Ord>::end()   const noexcept { return const_iterator{this}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::reverse_iterator
+      pdict<Key, Val, Ord>::rbegin() noexcept { return reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::reverse_iterator
+      pdict<Key, Val, Ord>::rend()            { return reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_reverse_iterator
+      pdict<Key, Val, Ord>::rbegin() const noexcept { return const_reverse_iterator{end()}; }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_reverse_iterator
+      pdict<Key, Val, Ord>::rend()   const noexcept { return const_reverse_iterator{begin()}; }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_iterator
+      pdict<Key, Val, Ord>::cbegin() const noexcept { return begin(); }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_iterator
+      pdict<Key, Val, Ord>::cend()   const noexcept { return end(); }
+
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_reverse_iterator
+      pdict<Key, Val, Ord>::crbegin() const noexcept { return rbegin(); }
+   template<typename Key, typename Val, typename Ord> inline typename pdict<Key, Val, Ord>::const_reverse_iterator
+      pdict<Key, Val, Ord>::crend()   const noexcept { return rend(); }
+} // namespace aux
+
+} // namespace MNL_AUX_UUID
+
+# endif // # ifndef MNL_INCLUDED_PDICT